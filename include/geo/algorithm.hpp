@@ -8,6 +8,7 @@
 #ifndef GEO_ALGORITHM_HPP
 #define GEO_ALGORITHM_HPP
 
+#include "execution.hpp"
 #include "point.hpp"
 
 namespace geo
@@ -20,6 +21,43 @@ namespace geo
      */
     template<typename K, typename Iterator>
     point<K> centroid(Iterator first, Iterator last);
+
+    /**
+     * Computes the centroid of points in given range under an execution
+     * policy.
+     *
+     * Displacements from the first point are summed in K::metric pairwise
+     * in blocks with independent accumulators, so the rounding error grows
+     * only with the logarithm of the number of points. Parallel policies
+     * split the range across threads and combine per-thread partial sums
+     * pairwise, so the last bits of the result may depend on the number of
+     * threads.
+     *
+     * Assertion fails if the range is empty.
+     */
+    template<typename K, typename Policy, typename Iterator>
+    detail::enable_if_execution_policy<Policy, point<K>>
+    centroid(Policy&& policy, Iterator first, Iterator last);
+
+    /**
+     * Computes the weighted centroid of points in [first, last) where the
+     * weight of each point is given by the corresponding element of the
+     * range starting at weight_first.
+     *
+     * Assertion fails if the range is empty or the weights sum to zero.
+     */
+    template<typename K, typename Iterator, typename WeightIterator>
+    point<K> weighted_centroid(Iterator first, Iterator last,
+                               WeightIterator weight_first);
+
+    /**
+     * Computes the weighted centroid under an execution policy. Summation
+     * is done in the same way as the centroid() overload taking a policy.
+     */
+    template<typename K, typename Policy, typename Iterator, typename WeightIterator>
+    detail::enable_if_execution_policy<Policy, point<K>>
+    weighted_centroid(Policy&& policy, Iterator first, Iterator last,
+                      WeightIterator weight_first);
 }
 
 #include "algorithm.ipp"
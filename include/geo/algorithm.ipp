@@ -1,28 +1,247 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
 #include "algorithm.hpp"
 #include "assert.hpp"
+#include "execution.hpp"
 #include "point.hpp"
-#include "vector.hpp"
 
 namespace geo
 {
+    namespace detail
+    {
+        // Returns origin + moment / weight with the sum taken in the metric
+        // type, so that a narrow scalar type is rounded only once.
+        template<typename K>
+        point<K> displaced(point<K> const& origin,
+                           typename K::metric const* moment,
+                           typename K::metric weight) noexcept
+        {
+            using metric_type = typename K::metric;
+
+            point<K> result;
+            for (unsigned i = 0; i < K::dimension; ++i) {
+                result[i] = static_cast<typename K::scalar>(
+                    metric_type(origin[i]) + moment[i] / weight
+                );
+            }
+            return result;
+        }
+    }
+
     template<typename K, typename Iterator>
     point<K> centroid(Iterator first, Iterator last)
     {
         GEO_ASSERT(first != last);
 
+        using metric_type = typename K::metric;
+
         point<K> const local_origin = *first;
-        vector<K> mean;
+        metric_type sum[K::dimension] {};
         long num = 1;
 
         while (++first != last) {
-            mean += *first - local_origin;
+            point<K> const& p = *first;
+            for (unsigned i = 0; i < K::dimension; ++i) {
+                sum[i] += metric_type(p[i]) - metric_type(local_origin[i]);
+            }
             num += 1;
         }
-        mean /= static_cast<typename K::scalar>(num);
 
-        return local_origin + mean;
+        return detail::displaced(local_origin, sum, static_cast<metric_type>(num));
+    }
+
+    namespace detail
+    {
+        // Number of points summed directly before pairwise combination.
+        constexpr std::size_t centroid_block_size = 128;
+
+        // Minimum number of points worth a thread.
+        constexpr std::size_t centroid_grain = std::size_t(1) << 16;
+
+        // Weighted sum of displacements and the sum of weights. The sum is
+        // kept in the metric type, which may be wider than the scalar type,
+        // and displacements are taken after widening so that they are exact.
+        template<typename K, typename W>
+        struct centroid_moment
+        {
+            using metric_type = typename K::metric;
+
+            metric_type moment[K::dimension] {};
+            W weight {};
+
+            void add(point<K> const& p, point<K> const& origin, W w) noexcept
+            {
+                for (unsigned i = 0; i < K::dimension; ++i) {
+                    moment[i] += metric_type(w) * (metric_type(p[i]) - metric_type(origin[i]));
+                }
+                weight += w;
+            }
+
+            centroid_moment& operator+=(centroid_moment const& other) noexcept
+            {
+                for (unsigned i = 0; i < K::dimension; ++i) {
+                    moment[i] += other.moment[i];
+                }
+                weight += other.weight;
+                return *this;
+            }
+        };
+
+        // Weight source giving unit weight to every point. Weights are
+        // counted in an integer so that the count is exact.
+        struct unit_weights
+        {
+            using weight_type = std::size_t;
+
+            weight_type next() noexcept
+            {
+                return 1;
+            }
+
+            unit_weights advanced(std::size_t) const noexcept
+            {
+                return *this;
+            }
+        };
+
+        // Weight source reading weights from an iterator.
+        template<typename K, typename WeightIterator>
+        struct iterator_weights
+        {
+            using weight_type = typename K::metric;
+
+            WeightIterator iter;
+
+            weight_type next()
+            {
+                return static_cast<weight_type>(*iter++);
+            }
+
+            iterator_weights advanced(std::size_t n) const
+            {
+                return {std::next(iter, static_cast<std::ptrdiff_t>(n))};
+            }
+        };
+
+        // Sums count weighted displacements from origin in blocks, with four
+        // independent accumulators inside a block to break the dependency
+        // chain, and combines block sums pairwise using a binary counter.
+        template<typename K, typename Iterator, typename Weights>
+        centroid_moment<K, typename Weights::weight_type>
+        pairwise_moment(Iterator first, std::size_t count,
+                        point<K> const& origin, Weights weights)
+        {
+            using moment_type = centroid_moment<K, typename Weights::weight_type>;
+            constexpr unsigned lanes = 4;
+
+            // A binary counter of 64 levels suffices for any count.
+            moment_type partials[64];
+            unsigned levels[64];
+            unsigned depth = 0;
+
+            while (count > 0) {
+                std::size_t const block = std::min(count, centroid_block_size);
+                count -= block;
+
+                moment_type accum[lanes];
+                std::size_t i = 0;
+                for (; i + lanes <= block; i += lanes) {
+                    for (unsigned lane = 0; lane < lanes; ++lane) {
+                        accum[lane].add(*first++, origin, weights.next());
+                    }
+                }
+                for (; i < block; ++i) {
+                    accum[0].add(*first++, origin, weights.next());
+                }
+                accum[0] += accum[1];
+                accum[2] += accum[3];
+                accum[0] += accum[2];
+
+                partials[depth] = accum[0];
+                levels[depth] = 0;
+                depth++;
+
+                while (depth >= 2 && levels[depth - 2] == levels[depth - 1]) {
+                    partials[depth - 2] += partials[depth - 1];
+                    levels[depth - 2]++;
+                    depth--;
+                }
+            }
+
+            moment_type total;
+            while (depth > 0) {
+                total += partials[--depth];
+            }
+            return total;
+        }
+
+        template<typename K, typename Policy, typename Iterator, typename Weights>
+        point<K> centroid(Policy const& policy, Iterator first, Iterator last,
+                          Weights weights)
+        {
+            GEO_ASSERT(first != last);
+
+            using moment_type = centroid_moment<K, typename Weights::weight_type>;
+
+            point<K> const origin = *first;
+            auto const count = static_cast<std::size_t>(std::distance(first, last));
+            unsigned const threads = thread_count(policy, count, centroid_grain);
+
+            std::vector<moment_type> partials(threads);
+            parallel_chunks(threads, count, [&](unsigned chunk,
+                                                std::size_t begin,
+                                                std::size_t end) {
+                partials[chunk] = pairwise_moment(
+                    std::next(first, static_cast<std::ptrdiff_t>(begin)),
+                    end - begin,
+                    origin,
+                    weights.advanced(begin)
+                );
+            });
+
+            for (std::size_t stride = 1; stride < partials.size(); stride *= 2) {
+                for (std::size_t i = 0; i + stride < partials.size(); i += 2 * stride) {
+                    partials[i] += partials[i + stride];
+                }
+            }
+
+            GEO_ASSERT(partials[0].weight != 0);
+            return displaced(
+                origin,
+                partials[0].moment,
+                static_cast<typename K::metric>(partials[0].weight)
+            );
+        }
+    }
+
+    template<typename K, typename Policy, typename Iterator>
+    detail::enable_if_execution_policy<Policy, point<K>>
+    centroid(Policy&& policy, Iterator first, Iterator last)
+    {
+        return detail::centroid<K>(policy, first, last, detail::unit_weights {});
+    }
+
+    template<typename K, typename Iterator, typename WeightIterator>
+    point<K> weighted_centroid(Iterator first, Iterator last,
+                               WeightIterator weight_first)
+    {
+        return weighted_centroid<K>(execution::seq, first, last, weight_first);
+    }
+
+    template<typename K, typename Policy, typename Iterator, typename WeightIterator>
+    detail::enable_if_execution_policy<Policy, point<K>>
+    weighted_centroid(Policy&& policy, Iterator first, Iterator last,
+                      WeightIterator weight_first)
+    {
+        return detail::centroid<K>(
+            policy, first, last,
+            detail::iterator_weights<K, WeightIterator> {weight_first}
+        );
     }
 }
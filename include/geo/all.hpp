@@ -11,12 +11,38 @@
 #include "algorithm.hpp"
 #include "approx_sphere.hpp"
 #include "assert.hpp"
+#include "batch.hpp"
+#include "binary_io.hpp"
 #include "box.hpp"
+#include "bvh.hpp"
+#include "cell_list.hpp"
+#include "dynamic_arena.hpp"
+#include "dynamic_kernel.hpp"
+#include "dynamic_point.hpp"
+#include "dynamic_vector.hpp"
 #include "ellipsoid.hpp"
+#include "execution.hpp"
+#include "integer_kernel.hpp"
+#include "kd_tree.hpp"
+#include "linear_transformation.hpp"
+#include "mixed_precision_kernel.hpp"
+#include "octree.hpp"
+#include "oriented_box.hpp"
+#include "oriented_ellipsoid.hpp"
+#include "pair_engine.hpp"
+#include "periodic_box.hpp"
 #include "point.hpp"
+#include "point_soa.hpp"
+#include "quantizer.hpp"
 #include "scaling_transformation.hpp"
+#include "shape_evaluation.hpp"
+#include "shape_pool.hpp"
+#include "space_filling_curve.hpp"
 #include "sphere.hpp"
 #include "standard_kernel.hpp"
+#include "sweep_and_prune.hpp"
+#include "text_io.hpp"
 #include "vector.hpp"
+#include "verlet_list.hpp"
 
 #endif
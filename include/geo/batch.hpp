@@ -0,0 +1,213 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Batch operations over ranges of points and vectors.
+//
+
+#ifndef GEO_BATCH_HPP
+#define GEO_BATCH_HPP
+
+#include <cstddef>
+
+#include "ellipsoid.hpp"
+#include "point.hpp"
+#include "point_soa.hpp"
+#include "sphere.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Computes squared distances from a point to every point in given range.
+     *
+     * The result for the i-th point of the range is written to the i-th
+     * element of the output range. Returns the end of the output range.
+     *
+     * Points are processed in blocks that are transposed to structure of
+     * arrays and fed to SIMD kernels if the kernel scalar is float or double.
+     * The instruction set (SSE2, AVX2 or AVX-512) is picked at runtime.
+     */
+    template<typename K, typename Iterator, typename OutputIterator>
+    OutputIterator squared_distances(point<K> const& p,
+                                     Iterator first, Iterator last,
+                                     OutputIterator out);
+
+    /**
+     * Computes squared distances from a point to every point in container.
+     *
+     * The output array must have points.size() elements. This overload runs
+     * the SIMD kernel directly on the axis arrays without transposition.
+     */
+    template<typename K>
+    void squared_distances(point<K> const& p,
+                           point_soa<K> const& points,
+                           typename K::metric* out) noexcept;
+
+    /**
+     * Computes squared distances between every pair of points taken from two
+     * ranges.
+     *
+     * The results are written in row-major order: the distance between the
+     * i-th point of the first range and the j-th point of the second range is
+     * written to out[i * n2 + j] where n2 is the length of the second range.
+     * Returns the end of the output range.
+     */
+    template<typename Iterator1, typename Iterator2, typename OutputIterator>
+    OutputIterator squared_distances(Iterator1 first1, Iterator1 last1,
+                                     Iterator2 first2, Iterator2 last2,
+                                     OutputIterator out);
+
+    /**
+     * Computes inner products of a vector and every vector in given range.
+     *
+     * The result for the i-th vector of the range is written to the i-th
+     * element of the output range. Returns the end of the output range.
+     */
+    template<typename K, typename Iterator, typename OutputIterator>
+    OutputIterator inner_products(vector<K> const& u,
+                                  Iterator first, Iterator last,
+                                  OutputIterator out);
+
+    /**
+     * Computes inner products of every pair of vectors taken from two ranges.
+     *
+     * The results are written in the same row-major order as in the
+     * many-to-many squared_distances(). Returns the end of the output range.
+     */
+    template<typename Iterator1, typename Iterator2, typename OutputIterator>
+    OutputIterator inner_products(Iterator1 first1, Iterator1 last1,
+                                  Iterator2 first2, Iterator2 last2,
+                                  OutputIterator out);
+
+    /**
+     * Evaluates the implicit function of shape at each of count points.
+     *
+     * Shape is sphere or ellipsoid. The result for points[i] is written to
+     * out[i]. Points are transposed in blocks to structure of arrays, and
+     * every query is computed axis by axis across the block so that the
+     * loops vectorize. Intermediate values shared between the terms of a
+     * query are computed once per point.
+     */
+    template<typename Shape>
+    void potentials(Shape const& shape,
+                    point<typename Shape::kernel> const* points,
+                    std::size_t count,
+                    typename Shape::metric_type* out);
+
+    /**
+     * Evaluates the implicit function of shape at every point in container.
+     * The output array must have points.size() elements.
+     */
+    template<typename Shape>
+    void potentials(Shape const& shape,
+                    point_soa<typename Shape::kernel> const& points,
+                    typename Shape::metric_type* out);
+
+    /**
+     * Evaluates the gradient of implicit function of shape at each of count
+     * points.
+     */
+    template<typename Shape>
+    void gradients(Shape const& shape,
+                   point<typename Shape::kernel> const* points,
+                   std::size_t count,
+                   typename Shape::vector_type* out);
+
+    /**
+     * Evaluates the gradient of implicit function of shape at every point in
+     * container.
+     */
+    template<typename Shape>
+    void gradients(Shape const& shape,
+                   point_soa<typename Shape::kernel> const& points,
+                   typename Shape::vector_type* out);
+
+    /**
+     * Computes the oriented distance from each of count points to the
+     * surface of shape. Results are the same as shape.oriented_distance()
+     * up to rounding.
+     */
+    template<typename Shape>
+    void oriented_distances(Shape const& shape,
+                            point<typename Shape::kernel> const* points,
+                            std::size_t count,
+                            typename Shape::metric_type* out);
+
+    /**
+     * Computes the oriented distance from every point in container to the
+     * surface of shape.
+     */
+    template<typename Shape>
+    void oriented_distances(Shape const& shape,
+                            point_soa<typename Shape::kernel> const& points,
+                            typename Shape::metric_type* out);
+
+    /**
+     * Computes the skin map of shape at each of count points. Results are
+     * the same as shape.skin_map() up to rounding.
+     */
+    template<typename Shape>
+    void skin_maps(Shape const& shape,
+                   point<typename Shape::kernel> const* points,
+                   std::size_t count,
+                   typename Shape::scaling_type* out);
+
+    /**
+     * Computes the skin map of shape at every point in container.
+     */
+    template<typename Shape>
+    void skin_maps(Shape const& shape,
+                   point_soa<typename Shape::kernel> const& points,
+                   typename Shape::scaling_type* out);
+
+    /**
+     * Computes the exact oriented distance from each of count points to the
+     * surface of ellipsoid. Results are the same as
+     * e.exact_oriented_distance() up to rounding.
+     *
+     * Blocks of points take a fixed number of Newton steps side by side in
+     * SIMD lanes, so that no lane waits for another. The few points whose
+     * iteration has not settled by then, which lie close to the plane of
+     * the longer semiaxes, are finished one by one with the safeguarded
+     * iteration of ellipsoid::exact_oriented_distance().
+     */
+    template<typename K>
+    void exact_oriented_distances(ellipsoid<K> const& e,
+                                  point<K> const* points,
+                                  std::size_t count,
+                                  typename K::metric* out);
+
+    /**
+     * Computes the exact oriented distance from every point in container to
+     * the surface of ellipsoid.
+     */
+    template<typename K>
+    void exact_oriented_distances(ellipsoid<K> const& e,
+                                  point_soa<K> const& points,
+                                  typename K::metric* out);
+
+    /**
+     * Computes the point of the surface of ellipsoid closest to each of
+     * count points. Results are the same as e.closest_point() up to
+     * rounding. See exact_oriented_distances() for the method.
+     */
+    template<typename K>
+    void closest_points(ellipsoid<K> const& e,
+                        point<K> const* points,
+                        std::size_t count,
+                        point<K>* out);
+
+    /**
+     * Computes the point of the surface of ellipsoid closest to every point
+     * in container.
+     */
+    template<typename K>
+    void closest_points(ellipsoid<K> const& e,
+                        point_soa<K> const& points,
+                        point<K>* out);
+}
+
+#include "batch.ipp"
+
+#endif
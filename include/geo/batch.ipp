@@ -0,0 +1,787 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "batch.hpp"
+#include "ellipsoid.hpp"
+#include "internal/aligned_allocator.hpp"
+#include "internal/simd.hpp"
+#include "point.hpp"
+#include "point_soa.hpp"
+#include "sphere.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Number of points transposed at once. Small enough for the block of
+        // any low-dimensional kernel to stay in L1 cache.
+        constexpr std::size_t batch_block_size = 256;
+
+        // Calls fn(axes, n) for consecutive blocks of at most batch_block_size
+        // elements of given range, where axes[d] points to n contiguous
+        // coordinates of axis d.
+        template<typename K, typename Iterator, typename Fn>
+        void for_each_transposed_block(Iterator first, Iterator last, Fn fn)
+        {
+            using scalar_type = typename K::scalar;
+            constexpr unsigned dimension = K::dimension;
+
+            alignas(simd_alignment) scalar_type buffer[dimension][batch_block_size];
+            scalar_type const* axes[dimension];
+            for (unsigned d = 0; d < dimension; ++d) {
+                axes[d] = buffer[d];
+            }
+
+            while (first != last) {
+                std::size_t n = 0;
+                for (; n < batch_block_size && first != last; ++first, ++n) {
+                    auto&& x = *first;
+                    for (unsigned d = 0; d < dimension; ++d) {
+                        buffer[d][n] = x[d];
+                    }
+                }
+                fn(axes, n);
+            }
+        }
+
+        // Transposes the whole range into contiguous axis arrays.
+        template<typename K>
+        struct transposed_range
+        {
+            using scalar_type = typename K::scalar;
+
+            template<typename Iterator>
+            transposed_range(Iterator first, Iterator last)
+            {
+                // The length of the range is not known in advance, so the
+                // coordinates are gathered first and then transposed.
+                std::vector<scalar_type> data;
+                for (; first != last; ++first) {
+                    auto&& x = *first;
+                    for (unsigned d = 0; d < K::dimension; ++d) {
+                        data.push_back(x[d]);
+                    }
+                }
+                size = data.size() / K::dimension;
+
+                // Round the stride up so that every axis array is aligned.
+                std::size_t const stride =
+                    (size + simd_alignment - 1) / simd_alignment * simd_alignment;
+                storage.resize(stride * K::dimension);
+                for (std::size_t i = 0; i < size; ++i) {
+                    for (unsigned d = 0; d < K::dimension; ++d) {
+                        storage[d * stride + i] = data[i * K::dimension + d];
+                    }
+                }
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    axes[d] = storage.data() + d * stride;
+                }
+            }
+
+            std::vector<scalar_type, aligned_allocator<scalar_type>> storage;
+            scalar_type const* axes[K::dimension];
+            std::size_t size;
+        };
+
+        // SIMD kernels read K::scalar and accumulate in K::metric. They are
+        // usable if the kernel measures in the same type, or in double while
+        // storing float.
+        template<typename K>
+        using batch_simd_enabled = std::integral_constant<
+            bool,
+            std::is_same<typename K::scalar, typename K::metric>::value ||
+            (std::is_same<typename K::scalar, float>::value &&
+             std::is_same<typename K::metric, double>::value)
+        >;
+
+        template<typename K, typename Iterator, typename OutputIterator>
+        OutputIterator squared_distances(point<K> const& p,
+                                         Iterator first, Iterator last,
+                                         OutputIterator out,
+                                         std::true_type)
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            for_each_transposed_block<K>(
+                first, last,
+                [&](scalar_type const* const* axes, std::size_t n) {
+                    metric_type result[batch_block_size];
+                    simd_squared_distances<scalar_type, K::dimension>(
+                        &p[0], axes, n, result
+                    );
+                    out = std::copy(result, result + n, out);
+                }
+            );
+            return out;
+        }
+
+        template<typename K, typename Iterator, typename OutputIterator>
+        OutputIterator squared_distances(point<K> const& p,
+                                         Iterator first, Iterator last,
+                                         OutputIterator out,
+                                         std::false_type)
+        {
+            for (; first != last; ++first) {
+                *out++ = squared_distance(p, point<K>(*first));
+            }
+            return out;
+        }
+
+        template<typename K>
+        void squared_distances(point<K> const& p,
+                               point_soa<K> const& points,
+                               typename K::metric* out,
+                               std::true_type) noexcept
+        {
+            using scalar_type = typename K::scalar;
+
+            scalar_type const* axes[K::dimension];
+            for (unsigned d = 0; d < K::dimension; ++d) {
+                axes[d] = points.axis(d);
+            }
+            simd_squared_distances<scalar_type, K::dimension>(
+                &p[0], axes, points.size(), out
+            );
+        }
+
+        template<typename K>
+        void squared_distances(point<K> const& p,
+                               point_soa<K> const& points,
+                               typename K::metric* out,
+                               std::false_type) noexcept
+        {
+            squared_distances(p, points.begin(), points.end(), out, std::false_type{});
+        }
+
+        template<typename K, typename Iterator, typename OutputIterator>
+        OutputIterator inner_products(vector<K> const& u,
+                                      Iterator first, Iterator last,
+                                      OutputIterator out,
+                                      std::true_type)
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            for_each_transposed_block<K>(
+                first, last,
+                [&](scalar_type const* const* axes, std::size_t n) {
+                    metric_type result[batch_block_size];
+                    simd_inner_products<scalar_type, K::dimension>(
+                        &u[0], axes, n, result
+                    );
+                    out = std::copy(result, result + n, out);
+                }
+            );
+            return out;
+        }
+
+        template<typename K, typename Iterator, typename OutputIterator>
+        OutputIterator inner_products(vector<K> const& u,
+                                      Iterator first, Iterator last,
+                                      OutputIterator out,
+                                      std::false_type)
+        {
+            for (; first != last; ++first) {
+                *out++ = inner_product(u, vector<K>(*first));
+            }
+            return out;
+        }
+    }
+
+    // One-to-many -------------------------------------------------------------
+
+    template<typename K, typename Iterator, typename OutputIterator>
+    OutputIterator squared_distances(point<K> const& p,
+                                     Iterator first, Iterator last,
+                                     OutputIterator out)
+    {
+        return detail::squared_distances(
+            p, first, last, out, detail::batch_simd_enabled<K>{}
+        );
+    }
+
+    template<typename K>
+    void squared_distances(point<K> const& p,
+                           point_soa<K> const& points,
+                           typename K::metric* out) noexcept
+    {
+        detail::squared_distances(p, points, out, detail::batch_simd_enabled<K>{});
+    }
+
+    template<typename K, typename Iterator, typename OutputIterator>
+    OutputIterator inner_products(vector<K> const& u,
+                                  Iterator first, Iterator last,
+                                  OutputIterator out)
+    {
+        return detail::inner_products(
+            u, first, last, out, detail::batch_simd_enabled<K>{}
+        );
+    }
+
+    // Many-to-many ------------------------------------------------------------
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator>
+    OutputIterator squared_distances(Iterator1 first1, Iterator1 last1,
+                                     Iterator2 first2, Iterator2 last2,
+                                     OutputIterator out)
+    {
+        using point_type = typename std::iterator_traits<Iterator1>::value_type;
+        using K = typename point_type::kernel;
+        using scalar_type = typename K::scalar;
+        using metric_type = typename K::metric;
+
+        if (!detail::batch_simd_enabled<K>::value) {
+            for (; first1 != last1; ++first1) {
+                out = detail::squared_distances(
+                    point_type(*first1), first2, last2, out, std::false_type{}
+                );
+            }
+            return out;
+        }
+
+        detail::transposed_range<K> const columns(first2, last2);
+        std::vector<metric_type> row(columns.size);
+
+        for (; first1 != last1; ++first1) {
+            point_type const p = *first1;
+            detail::simd_squared_distances<scalar_type, K::dimension>(
+                &p[0], columns.axes, columns.size, row.data()
+            );
+            out = std::copy(row.begin(), row.end(), out);
+        }
+        return out;
+    }
+
+    template<typename Iterator1, typename Iterator2, typename OutputIterator>
+    OutputIterator inner_products(Iterator1 first1, Iterator1 last1,
+                                  Iterator2 first2, Iterator2 last2,
+                                  OutputIterator out)
+    {
+        using vector_type = typename std::iterator_traits<Iterator1>::value_type;
+        using K = typename vector_type::kernel;
+        using scalar_type = typename K::scalar;
+        using metric_type = typename K::metric;
+
+        if (!detail::batch_simd_enabled<K>::value) {
+            for (; first1 != last1; ++first1) {
+                out = detail::inner_products(
+                    vector_type(*first1), first2, last2, out, std::false_type{}
+                );
+            }
+            return out;
+        }
+
+        detail::transposed_range<K> const columns(first2, last2);
+        std::vector<metric_type> row(columns.size);
+
+        for (; first1 != last1; ++first1) {
+            vector_type const u = *first1;
+            detail::simd_inner_products<scalar_type, K::dimension>(
+                &u[0], columns.axes, columns.size, row.data()
+            );
+            out = std::copy(row.begin(), row.end(), out);
+        }
+        return out;
+    }
+
+    // Shape queries -----------------------------------------------------------
+
+    namespace detail
+    {
+        // Calls fn(axes, n, offset) for consecutive blocks of at most
+        // batch_block_size points of container, where offset is the index of
+        // the first point of the block.
+        template<typename K, typename Fn>
+        void for_each_axis_block(point_soa<K> const& points, Fn fn)
+        {
+            using scalar_type = typename K::scalar;
+
+            for (std::size_t offset = 0; offset < points.size(); offset += batch_block_size) {
+                scalar_type const* axes[K::dimension];
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    axes[d] = points.axis(d) + offset;
+                }
+                fn(axes, std::min(batch_block_size, points.size() - offset), offset);
+            }
+        }
+
+        // Same as above for an array of points, which is transposed block by
+        // block.
+        template<typename K, typename Fn>
+        void for_each_axis_block(point<K> const* points, std::size_t count, Fn fn)
+        {
+            using scalar_type = typename K::scalar;
+
+            std::size_t offset = 0;
+            for_each_transposed_block<K>(
+                points, points + count,
+                [&](scalar_type const* const* axes, std::size_t n) {
+                    fn(axes, n, offset);
+                    offset += n;
+                }
+            );
+        }
+
+        // Sphere and ellipsoid are both the level set of quadratic form
+        // sum_d coeff[d] (x[d] - center[d])^2 - offset with diagonal
+        // coefficients. This struct holds the form and evaluates it axis by
+        // axis over blocks of points.
+        template<typename K>
+        struct batch_quadric
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            // Coefficients are held in metric_type, so that coordinates are
+            // widened before subtraction when the kernel stores them in a
+            // narrower type.
+            metric_type center[K::dimension];
+            metric_type coeff[K::dimension];
+            metric_type offset;
+
+            explicit
+            batch_quadric(sphere<K> const& s) noexcept
+                : offset {s.squared_radius()}
+            {
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    center[d] = s.center()[d];
+                    coeff[d] = metric_type(1);
+                }
+            }
+
+            explicit
+            batch_quadric(ellipsoid<K> const& e) noexcept
+                : offset {metric_type(1)}
+            {
+                auto const semiaxes = e.semiaxes();
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const semiaxis = semiaxes[d];
+                    center[d] = e.center()[d];
+                    coeff[d] = metric_type(1) / (semiaxis * semiaxis);
+                }
+            }
+
+            void potentials(scalar_type const* const* axes, std::size_t n,
+                            metric_type* pot) const noexcept
+            {
+                std::fill(pot, pot + n, -offset);
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const c = center[d];
+                    metric_type const q = coeff[d];
+                    scalar_type const* x = axes[d];
+                    for (std::size_t i = 0; i < n; ++i) {
+                        metric_type const r = metric_type(x[i]) - c;
+                        pot[i] += q * r * r;
+                    }
+                }
+            }
+
+            // Computes the potential and the squared norm of the gradient in
+            // one pass over the axes.
+            void potentials(scalar_type const* const* axes, std::size_t n,
+                            metric_type* pot, metric_type* grad2) const noexcept
+            {
+                std::fill(pot, pot + n, -offset);
+                std::fill(grad2, grad2 + n, metric_type(0));
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const c = center[d];
+                    metric_type const q = coeff[d];
+                    scalar_type const* x = axes[d];
+                    for (std::size_t i = 0; i < n; ++i) {
+                        metric_type const r = metric_type(x[i]) - c;
+                        metric_type const g = 2 * q * r;
+                        pot[i] += q * r * r;
+                        grad2[i] += g * g;
+                    }
+                }
+            }
+
+            void gradients(scalar_type const* const* axes, std::size_t n,
+                           vector<K>* out) const noexcept
+            {
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const c = center[d];
+                    metric_type const q2 = 2 * coeff[d];
+                    scalar_type const* x = axes[d];
+                    for (std::size_t i = 0; i < n; ++i) {
+                        out[i][d] = static_cast<scalar_type>(q2 * (metric_type(x[i]) - c));
+                    }
+                }
+            }
+
+            void squared_distances(scalar_type const* const* axes, std::size_t n,
+                                   metric_type* out) const noexcept
+            {
+                std::fill(out, out + n, metric_type(0));
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const c = center[d];
+                    scalar_type const* x = axes[d];
+                    for (std::size_t i = 0; i < n; ++i) {
+                        metric_type const r = metric_type(x[i]) - c;
+                        out[i] += r * r;
+                    }
+                }
+            }
+        };
+
+        // Shape-specific parts of oriented_distances() and skin_maps() for a
+        // block of points.
+
+        template<typename K>
+        void oriented_distances(sphere<K> const& s,
+                                batch_quadric<K> const& quadric,
+                                typename K::scalar const* const* axes,
+                                std::size_t n,
+                                typename K::metric* out)
+        {
+            auto const radius = s.radius();
+            quadric.squared_distances(axes, n, out);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = K::sqrt(out[i]) - radius;
+            }
+        }
+
+        template<typename K>
+        void oriented_distances(ellipsoid<K> const&,
+                                batch_quadric<K> const& quadric,
+                                typename K::scalar const* const* axes,
+                                std::size_t n,
+                                typename K::metric* out)
+        {
+            typename K::metric grad2[batch_block_size];
+            quadric.potentials(axes, n, out, grad2);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] /= K::sqrt(grad2[i]);
+            }
+        }
+
+        template<typename K>
+        void skin_maps(sphere<K> const& s,
+                       batch_quadric<K> const& quadric,
+                       typename K::scalar const* const* axes,
+                       std::size_t n,
+                       scaling_transformation<K>* out)
+        {
+            using scalar_type = typename K::scalar;
+
+            auto const radius = s.radius();
+            typename K::metric dist2[batch_block_size];
+            quadric.squared_distances(axes, n, dist2);
+            for (std::size_t i = 0; i < n; ++i) {
+                out[i] = static_cast<scalar_type>(1 - radius / K::sqrt(dist2[i]));
+            }
+        }
+
+        template<typename K>
+        void skin_maps(ellipsoid<K> const&,
+                       batch_quadric<K> const& quadric,
+                       typename K::scalar const* const* axes,
+                       std::size_t n,
+                       scaling_transformation<K>* out)
+        {
+            typename K::metric pot[batch_block_size];
+            typename K::metric grad2[batch_block_size];
+            quadric.potentials(axes, n, pot, grad2);
+            for (std::size_t i = 0; i < n; ++i) {
+                auto const factor = 2 * pot[i] / grad2[i];
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    out[i][d] = static_cast<typename K::scalar>(factor * quadric.coeff[d]);
+                }
+            }
+        }
+
+        template<typename Shape, typename Points, typename Output>
+        void potentials(Shape const& shape, Points const& blocks, Output* out)
+        {
+            using K = typename Shape::kernel;
+            using scalar_type = typename K::scalar;
+
+            batch_quadric<K> const quadric {shape};
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                quadric.potentials(axes, n, out + offset);
+            });
+        }
+
+        template<typename Shape, typename Points, typename Output>
+        void gradients(Shape const& shape, Points const& blocks, Output* out)
+        {
+            using K = typename Shape::kernel;
+            using scalar_type = typename K::scalar;
+
+            batch_quadric<K> const quadric {shape};
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                quadric.gradients(axes, n, out + offset);
+            });
+        }
+
+        template<typename Shape, typename Points, typename Output>
+        void oriented_distances(Shape const& shape, Points const& blocks, Output* out)
+        {
+            using K = typename Shape::kernel;
+            using scalar_type = typename K::scalar;
+
+            batch_quadric<K> const quadric {shape};
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                detail::oriented_distances(shape, quadric, axes, n, out + offset);
+            });
+        }
+
+        template<typename Shape, typename Points, typename Output>
+        void skin_maps(Shape const& shape, Points const& blocks, Output* out)
+        {
+            using K = typename Shape::kernel;
+            using scalar_type = typename K::scalar;
+
+            batch_quadric<K> const quadric {shape};
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                detail::skin_maps(shape, quadric, axes, n, out + offset);
+            });
+        }
+
+        // Runs the lane kernel over a block of points and calls
+        // fn(i, s, y, x) for every point of the block, where y holds the
+        // distances of the point from the center along the axes, s is the
+        // root of its secular equation and x its foot in the frame of the
+        // ellipsoid. Points left unconverged by the kernel are solved again
+        // with the safeguarded iteration, and feet on the medial plane are
+        // completed by the frame.
+        template<typename K, typename Fn>
+        void for_each_ellipsoid_foot(ellipsoid_frame<K> const& frame,
+                                     typename K::metric const* center,
+                                     typename K::scalar const* const* axes,
+                                     std::size_t n,
+                                     Fn fn)
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            metric_type roots[batch_block_size];
+            alignas(simd_alignment) metric_type feet[K::dimension][batch_block_size];
+            unsigned char converged[batch_block_size];
+            metric_type* feet_axes[K::dimension];
+            for (unsigned d = 0; d < K::dimension; ++d) {
+                feet_axes[d] = feet[d];
+            }
+            simd_ellipsoid_feet<scalar_type, K::dimension, metric_type>(
+                center, frame.semiaxes, frame.gaps, axes, n, roots, feet_axes, converged
+            );
+
+            for (std::size_t i = 0; i < n; ++i) {
+                metric_type y[K::dimension];
+                metric_type x[K::dimension];
+                for (unsigned d = 0; d < K::dimension; ++d) {
+                    metric_type const r = metric_type(axes[d][i]) - center[d];
+                    y[d] = r < 0 ? -r : r;
+                    x[d] = feet[d][i];
+                }
+
+                metric_type s = roots[i];
+                if (!converged[i] || s <= 0) {
+                    if (!converged[i]) {
+                        s = frame.root(y);
+                    }
+                    frame.foot(y, s, x);
+                }
+                fn(i, s, y, x);
+            }
+        }
+
+        template<typename K, typename Points>
+        void exact_oriented_distances(ellipsoid<K> const& e, Points const& blocks,
+                                      typename K::metric* out)
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            ellipsoid_frame<K> const frame {e};
+            metric_type center[K::dimension];
+            for (unsigned d = 0; d < K::dimension; ++d) {
+                center[d] = e.center()[d];
+            }
+
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                for_each_ellipsoid_foot(
+                    frame, center, axes, n,
+                    [&](std::size_t i, metric_type s,
+                        metric_type const* y, metric_type const* x) {
+                        out[offset + i] = frame.oriented_distance(y, s, x);
+                    }
+                );
+            });
+        }
+
+        template<typename K, typename Points>
+        void closest_points(ellipsoid<K> const& e, Points const& blocks, point<K>* out)
+        {
+            using scalar_type = typename K::scalar;
+            using metric_type = typename K::metric;
+
+            ellipsoid_frame<K> const frame {e};
+            metric_type center[K::dimension];
+            for (unsigned d = 0; d < K::dimension; ++d) {
+                center[d] = e.center()[d];
+            }
+
+            blocks([&](scalar_type const* const* axes, std::size_t n, std::size_t offset) {
+                for_each_ellipsoid_foot(
+                    frame, center, axes, n,
+                    [&](std::size_t i, metric_type,
+                        metric_type const*, metric_type const* x) {
+                        point<K>& result = out[offset + i];
+                        for (unsigned d = 0; d < K::dimension; ++d) {
+                            bool const negative = metric_type(axes[d][i]) < center[d];
+                            result[d] = static_cast<scalar_type>(
+                                center[d] + (negative ? -x[d] : x[d])
+                            );
+                        }
+                    }
+                );
+            });
+        }
+
+        // Adapters passing blocks of points to a block function.
+
+        template<typename K>
+        struct array_blocks
+        {
+            point<K> const* points;
+            std::size_t count;
+
+            template<typename Fn>
+            void operator()(Fn fn) const
+            {
+                for_each_axis_block<K>(points, count, fn);
+            }
+        };
+
+        template<typename K>
+        struct soa_blocks
+        {
+            point_soa<K> const& points;
+
+            template<typename Fn>
+            void operator()(Fn fn) const
+            {
+                for_each_axis_block<K>(points, fn);
+            }
+        };
+    }
+
+    template<typename Shape>
+    void potentials(Shape const& shape,
+                    point<typename Shape::kernel> const* points,
+                    std::size_t count,
+                    typename Shape::metric_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::potentials(shape, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename Shape>
+    void potentials(Shape const& shape,
+                    point_soa<typename Shape::kernel> const& points,
+                    typename Shape::metric_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::potentials(shape, detail::soa_blocks<K> {points}, out);
+    }
+
+    template<typename Shape>
+    void gradients(Shape const& shape,
+                   point<typename Shape::kernel> const* points,
+                   std::size_t count,
+                   typename Shape::vector_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::gradients(shape, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename Shape>
+    void gradients(Shape const& shape,
+                   point_soa<typename Shape::kernel> const& points,
+                   typename Shape::vector_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::gradients(shape, detail::soa_blocks<K> {points}, out);
+    }
+
+    template<typename Shape>
+    void oriented_distances(Shape const& shape,
+                            point<typename Shape::kernel> const* points,
+                            std::size_t count,
+                            typename Shape::metric_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::oriented_distances(shape, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename Shape>
+    void oriented_distances(Shape const& shape,
+                            point_soa<typename Shape::kernel> const& points,
+                            typename Shape::metric_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::oriented_distances(shape, detail::soa_blocks<K> {points}, out);
+    }
+
+    template<typename Shape>
+    void skin_maps(Shape const& shape,
+                   point<typename Shape::kernel> const* points,
+                   std::size_t count,
+                   typename Shape::scaling_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::skin_maps(shape, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename Shape>
+    void skin_maps(Shape const& shape,
+                   point_soa<typename Shape::kernel> const& points,
+                   typename Shape::scaling_type* out)
+    {
+        using K = typename Shape::kernel;
+        detail::skin_maps(shape, detail::soa_blocks<K> {points}, out);
+    }
+
+    template<typename K>
+    void exact_oriented_distances(ellipsoid<K> const& e,
+                                  point<K> const* points,
+                                  std::size_t count,
+                                  typename K::metric* out)
+    {
+        detail::exact_oriented_distances(e, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename K>
+    void exact_oriented_distances(ellipsoid<K> const& e,
+                                  point_soa<K> const& points,
+                                  typename K::metric* out)
+    {
+        detail::exact_oriented_distances(e, detail::soa_blocks<K> {points}, out);
+    }
+
+    template<typename K>
+    void closest_points(ellipsoid<K> const& e,
+                        point<K> const* points,
+                        std::size_t count,
+                        point<K>* out)
+    {
+        detail::closest_points(e, detail::array_blocks<K> {points, count}, out);
+    }
+
+    template<typename K>
+    void closest_points(ellipsoid<K> const& e,
+                        point_soa<K> const& points,
+                        point<K>* out)
+    {
+        detail::closest_points(e, detail::soa_blocks<K> {points}, out);
+    }
+}
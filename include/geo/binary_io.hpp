@@ -0,0 +1,208 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Binary point-cloud files.
+//
+
+#ifndef GEO_BINARY_IO_HPP
+#define GEO_BINARY_IO_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "point.hpp"
+
+#if !defined(GEO_DISABLE_MMAP) && (defined(__unix__) || defined(__APPLE__))
+# define GEO_HAS_MMAP 1
+#else
+# define GEO_HAS_MMAP 0
+#endif
+
+namespace geo
+{
+    /**
+     * Header of binary point-cloud file.
+     *
+     * A file consists of this header followed, at data_offset bytes from
+     * the start, by count objects of point<K> stored as they are in memory
+     * (including padding lanes of padded kernels). data_offset is a multiple
+     * of 64 so that memory-mapped data is suitably aligned for any kernel.
+     *
+     * The header records the byte order, the kind and size of the scalar
+     * type, the dimension and the size of point<K>, so that a file is read
+     * only by a program using the same point layout.
+     */
+    struct binary_header
+    {
+        /**
+         * File signature.
+         */
+        char magic[8];
+
+        /**
+         * Always 0x01020304 in the byte order of the writer.
+         */
+        std::uint32_t byte_order;
+
+        /**
+         * Format version.
+         */
+        std::uint32_t version;
+
+        /**
+         * 'f' for floating-point scalars, 'i' and 'u' for signed and unsigned
+         * integral scalars.
+         */
+        std::uint32_t scalar_kind;
+
+        /**
+         * Size of scalar in bytes.
+         */
+        std::uint32_t scalar_size;
+
+        /**
+         * Dimension of the kernel.
+         */
+        std::uint32_t dimension;
+
+        /**
+         * Size of point<K> in bytes.
+         */
+        std::uint32_t point_size;
+
+        /**
+         * Number of points.
+         */
+        std::uint64_t count;
+
+        /**
+         * Offset of the first point from the start of file.
+         */
+        std::uint64_t data_offset;
+
+        /**
+         * Returns the header describing count points of kernel K.
+         */
+        template<typename K>
+        static binary_header describe(std::size_t count) noexcept;
+
+        /**
+         * Returns true if this header is valid and describes points of
+         * kernel K.
+         */
+        template<typename K>
+        bool matches() const noexcept;
+    };
+
+    /**
+     * Writes points in [first, last) to out in the binary format. Sets
+     * failbit of out on error. Returns out.
+     *
+     * Iterator must be a forward iterator since the points are counted
+     * before they are written.
+     */
+    template<typename K, typename Iterator>
+    std::ostream& write_binary(std::ostream& out, Iterator first, Iterator last);
+
+    /**
+     * Reads points written by write_binary() from in and appends them to
+     * points. Sets failbit of in if the header does not match kernel K or
+     * the data is truncated. Returns in.
+     *
+     * Points are read in chunks of bounded size, so a corrupt count in the
+     * header fails when the data runs out rather than by allocating memory
+     * for all the points up front. points is left unchanged on failure.
+     */
+    template<typename K, typename Allocator>
+    std::istream& read_binary(std::istream& in, std::vector<point<K>, Allocator>& points);
+
+    /**
+     * Read-only view of points in a binary file.
+     *
+     * On POSIX systems the file is memory-mapped, so opening does not copy
+     * the points and pages are loaded on demand. Elsewhere (or if
+     * GEO_DISABLE_MMAP is defined) the points are read into an aligned
+     * buffer. The view is movable but not copyable.
+     */
+    template<typename K>
+    struct mapped_points
+    {
+        /**
+         * Type of points.
+         */
+        using value_type = point<K>;
+
+        /**
+         * Iterator type.
+         */
+        using const_iterator = point<K> const*;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty view.
+         */
+        mapped_points() = default;
+
+        /**
+         * Opens a binary file. Throws std::system_error if the file cannot be
+         * opened or mapped, and std::runtime_error if the header does not
+         * match kernel K or the file is truncated.
+         */
+        explicit
+        mapped_points(std::string const& path);
+
+        mapped_points(mapped_points&& other) noexcept;
+
+        mapped_points& operator=(mapped_points&& other) noexcept;
+
+        mapped_points(mapped_points const&) = delete;
+
+        mapped_points& operator=(mapped_points const&) = delete;
+
+        ~mapped_points();
+
+        // Access --------------------------------------------------------------
+
+        /**
+         * Returns the number of points.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if there is no point.
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Returns a pointer to the first point.
+         */
+        point<K> const* data() const noexcept;
+
+        /**
+         * Returns the i-th point.
+         */
+        point<K> const& operator[](std::size_t i) const noexcept;
+
+        const_iterator begin() const noexcept;
+
+        const_iterator end() const noexcept;
+
+      private:
+        void release() noexcept;
+
+        void const* mapping_ = nullptr;
+        std::size_t mapping_size_ = 0;
+        point<K> const* points_ = nullptr;
+        std::size_t size_ = 0;
+    };
+}
+
+#include "binary_io.ipp"
+
+#endif
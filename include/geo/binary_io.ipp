@@ -0,0 +1,363 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <istream>
+#include <iterator>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if GEO_HAS_MMAP
+# include <fcntl.h>
+# include <sys/mman.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include "assert.hpp"
+#include "binary_io.hpp"
+#include "internal/aligned_allocator.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        constexpr char binary_magic[8] = {'G', 'E', 'O', 'P', 'O', 'I', 'N', 'T'};
+        constexpr std::uint32_t binary_byte_order = 0x01020304;
+        constexpr std::uint32_t binary_version = 1;
+
+        // Header is padded to this size, which also aligns the point data.
+        constexpr std::uint64_t binary_data_offset = 64;
+
+        static_assert(sizeof(binary_header) <= binary_data_offset, "");
+
+        // read_binary() grows the output by at most this many bytes at once,
+        // so that a corrupt point count cannot request a huge allocation
+        // before the data runs out.
+        constexpr std::size_t binary_read_chunk = std::size_t(1) << 20;
+
+        template<typename T>
+        constexpr std::uint32_t binary_scalar_kind() noexcept
+        {
+            return std::is_floating_point<T>::value ? 'f'
+                 : std::is_signed<T>::value ? 'i'
+                 : 'u';
+        }
+    }
+
+    // binary_header -----------------------------------------------------------
+
+    template<typename K>
+    binary_header binary_header::describe(std::size_t count) noexcept
+    {
+        binary_header header {};
+        std::memcpy(header.magic, detail::binary_magic, sizeof header.magic);
+        header.byte_order = detail::binary_byte_order;
+        header.version = detail::binary_version;
+        header.scalar_kind = detail::binary_scalar_kind<typename K::scalar>();
+        header.scalar_size = sizeof(typename K::scalar);
+        header.dimension = K::dimension;
+        header.point_size = sizeof(point<K>);
+        header.count = count;
+        header.data_offset = detail::binary_data_offset;
+        return header;
+    }
+
+    template<typename K>
+    bool binary_header::matches() const noexcept
+    {
+        binary_header const expected = describe<K>(0);
+        return std::memcmp(magic, expected.magic, sizeof magic) == 0
+            && byte_order == expected.byte_order
+            && version == expected.version
+            && scalar_kind == expected.scalar_kind
+            && scalar_size == expected.scalar_size
+            && dimension == expected.dimension
+            && point_size == expected.point_size
+            && data_offset >= sizeof(binary_header)
+            && data_offset % alignof(point<K>) == 0;
+    }
+
+    // Stream I/O --------------------------------------------------------------
+
+    template<typename K, typename Iterator>
+    std::ostream& write_binary(std::ostream& out, Iterator first, Iterator last)
+    {
+        static_assert(std::is_trivially_copyable<point<K>>::value, "");
+        static_assert(std::is_base_of<
+            std::forward_iterator_tag,
+            typename std::iterator_traits<Iterator>::iterator_category
+        >::value, "");
+
+        auto const count = static_cast<std::size_t>(std::distance(first, last));
+        binary_header const header = binary_header::describe<K>(count);
+
+        char padding[detail::binary_data_offset] {};
+        out.write(reinterpret_cast<char const*>(&header), sizeof header);
+        out.write(padding, static_cast<std::streamsize>(header.data_offset - sizeof header));
+
+        for (; first != last && out; ++first) {
+            point<K> const p = *first;
+            out.write(reinterpret_cast<char const*>(&p), sizeof p);
+        }
+        return out;
+    }
+
+    template<typename K, typename Allocator>
+    std::istream& read_binary(std::istream& in, std::vector<point<K>, Allocator>& points)
+    {
+        static_assert(std::is_trivially_copyable<point<K>>::value, "");
+
+        binary_header header;
+        if (!in.read(reinterpret_cast<char*>(&header), sizeof header)) {
+            return in;
+        }
+        if (!header.matches<K>()) {
+            in.setstate(std::ios::failbit);
+            return in;
+        }
+        std::uint64_t const skip = header.data_offset - sizeof header;
+        if (skip > std::uint64_t(std::numeric_limits<std::streamsize>::max()) ||
+            header.count > points.max_size() - points.size()) {
+            in.setstate(std::ios::failbit);
+            return in;
+        }
+        if (in.ignore(static_cast<std::streamsize>(skip)).gcount() !=
+                static_cast<std::streamsize>(skip)) {
+            in.setstate(std::ios::failbit);
+            return in;
+        }
+
+        // Read in chunks: a truncated stream then fails after at most one
+        // chunk more than the data it has.
+        std::size_t const old_size = points.size();
+        std::size_t const chunk =
+            std::max(detail::binary_read_chunk / sizeof(point<K>), std::size_t(1));
+        auto remaining = static_cast<std::size_t>(header.count);
+        while (remaining > 0) {
+            std::size_t const n = std::min(remaining, chunk);
+            std::size_t const offset = points.size();
+            points.resize(offset + n);
+            if (!in.read(reinterpret_cast<char*>(points.data() + offset),
+                         static_cast<std::streamsize>(n * sizeof(point<K>)))) {
+                points.resize(old_size);
+                return in;
+            }
+            remaining -= n;
+        }
+        return in;
+    }
+
+    // mapped_points -----------------------------------------------------------
+
+    namespace detail
+    {
+        // Checks the header at the start of a file image of given size and
+        // returns the number of points. Throws std::runtime_error on error.
+        template<typename K>
+        std::size_t check_binary_image(void const* image, std::size_t size)
+        {
+            binary_header header;
+            if (size < sizeof header) {
+                throw std::runtime_error("geo: binary point file is truncated");
+            }
+            std::memcpy(&header, image, sizeof header);
+            if (!header.matches<K>()) {
+                throw std::runtime_error("geo: binary point file does not match the kernel");
+            }
+            if (header.data_offset > size ||
+                header.count > (size - header.data_offset) / sizeof(point<K>)) {
+                throw std::runtime_error("geo: binary point file is truncated");
+            }
+            return static_cast<std::size_t>(header.count);
+        }
+
+        // Offset of point data, valid after check_binary_image succeeded.
+        inline
+        std::size_t binary_data_offset_of(void const* image) noexcept
+        {
+            binary_header header;
+            std::memcpy(&header, image, sizeof header);
+            return static_cast<std::size_t>(header.data_offset);
+        }
+    }
+
+#if GEO_HAS_MMAP
+
+    template<typename K>
+    mapped_points<K>::mapped_points(std::string const& path)
+    {
+        int const fd = ::open(path.c_str(), O_RDONLY);
+        if (fd == -1) {
+            throw std::system_error(errno, std::generic_category(), path);
+        }
+
+        struct ::stat status;
+        if (::fstat(fd, &status) == -1) {
+            int const error = errno;
+            ::close(fd);
+            throw std::system_error(error, std::generic_category(), path);
+        }
+        auto const size = static_cast<std::size_t>(status.st_size);
+        if (size < sizeof(binary_header)) {
+            ::close(fd);
+            throw std::runtime_error("geo: binary point file is truncated");
+        }
+
+        void* const mapping = ::mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        int const error = errno;
+        ::close(fd);
+        if (mapping == MAP_FAILED) {
+            throw std::system_error(error, std::generic_category(), path);
+        }
+
+        mapping_ = mapping;
+        mapping_size_ = size;
+
+        try {
+            size_ = detail::check_binary_image<K>(mapping_, mapping_size_);
+        } catch (...) {
+            release();
+            throw;
+        }
+        points_ = reinterpret_cast<point<K> const*>(
+            static_cast<char const*>(mapping_) + detail::binary_data_offset_of(mapping_)
+        );
+    }
+
+    template<typename K>
+    void mapped_points<K>::release() noexcept
+    {
+        if (mapping_) {
+            ::munmap(const_cast<void*>(mapping_), mapping_size_);
+        }
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+        points_ = nullptr;
+        size_ = 0;
+    }
+
+#else
+
+    // Without mmap the whole file is read into an aligned buffer, which is
+    // owned through mapping_.
+
+    template<typename K>
+    mapped_points<K>::mapped_points(std::string const& path)
+    {
+        std::ifstream file {path, std::ios::binary};
+        if (!file) {
+            throw std::system_error(std::make_error_code(std::errc::io_error), path);
+        }
+        std::vector<char> image {std::istreambuf_iterator<char>(file),
+                                 std::istreambuf_iterator<char>()};
+
+        size_ = detail::check_binary_image<K>(image.data(), image.size());
+
+        using allocator = aligned_allocator<point<K>>;
+        point<K>* const buffer = allocator {}.allocate(size_ == 0 ? 1 : size_);
+        std::memcpy(buffer, image.data() + detail::binary_data_offset_of(image.data()),
+                    size_ * sizeof(point<K>));
+        mapping_ = buffer;
+        mapping_size_ = size_ == 0 ? 1 : size_;
+        points_ = buffer;
+    }
+
+    template<typename K>
+    void mapped_points<K>::release() noexcept
+    {
+        if (mapping_) {
+            using allocator = aligned_allocator<point<K>>;
+            allocator {}.deallocate(
+                static_cast<point<K>*>(const_cast<void*>(mapping_)), mapping_size_
+            );
+        }
+        mapping_ = nullptr;
+        mapping_size_ = 0;
+        points_ = nullptr;
+        size_ = 0;
+    }
+
+#endif
+
+    template<typename K>
+    mapped_points<K>::mapped_points(mapped_points&& other) noexcept
+        : mapping_ {other.mapping_}
+        , mapping_size_ {other.mapping_size_}
+        , points_ {other.points_}
+        , size_ {other.size_}
+    {
+        other.mapping_ = nullptr;
+        other.mapping_size_ = 0;
+        other.points_ = nullptr;
+        other.size_ = 0;
+    }
+
+    template<typename K>
+    auto mapped_points<K>::operator=(mapped_points&& other) noexcept -> mapped_points&
+    {
+        if (this != &other) {
+            release();
+            std::swap(mapping_, other.mapping_);
+            std::swap(mapping_size_, other.mapping_size_);
+            std::swap(points_, other.points_);
+            std::swap(size_, other.size_);
+        }
+        return *this;
+    }
+
+    template<typename K>
+    mapped_points<K>::~mapped_points()
+    {
+        release();
+    }
+
+    template<typename K>
+    std::size_t mapped_points<K>::size() const noexcept
+    {
+        return size_;
+    }
+
+    template<typename K>
+    bool mapped_points<K>::empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template<typename K>
+    point<K> const* mapped_points<K>::data() const noexcept
+    {
+        return points_;
+    }
+
+    template<typename K>
+    point<K> const& mapped_points<K>::operator[](std::size_t i) const noexcept
+    {
+        GEO_EXTRA_ASSERT(i < size_);
+        return points_[i];
+    }
+
+    template<typename K>
+    auto mapped_points<K>::begin() const noexcept -> const_iterator
+    {
+        return points_;
+    }
+
+    template<typename K>
+    auto mapped_points<K>::end() const noexcept -> const_iterator
+    {
+        return points_ + size_;
+    }
+}
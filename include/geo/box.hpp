@@ -99,10 +99,67 @@ namespace geo
         constexpr
         metric_type volume() const noexcept;
 
+        // Analytic query ------------------------------------------------------
+
+        /**
+         * Evaluates the implicit function.
+         *
+         * The implicit function of box is its oriented distance, so this
+         * function is the same as oriented_distance(p).
+         */
+        metric_type potential(point_type const& p) const noexcept;
+
+        /**
+         * Returns the shortest distance from point to the surface.
+         *
+         * The distance is oriented so that it is negative inside the box and
+         * positive outside the box. The absolute value gives usual distance.
+         */
+        metric_type oriented_distance(point_type const& p) const noexcept;
+
       private:
         point_type lowest_vertex_ {};
         point_type highest_vertex_ {};
     };
+
+    // Basic operations --------------------------------------------------------
+
+    /**
+     * Computes the squared Euclidean distance from a point to the nearest
+     * point in a box. Returns zero if the point is inside the box.
+     */
+    template<typename K>
+    constexpr
+    typename K::metric squared_distance(box<K> const& b,
+                                        point<K> const& p) noexcept;
+
+    template<typename K>
+    constexpr
+    typename K::metric squared_distance(point<K> const& p,
+                                        box<K> const& b) noexcept;
+
+    /**
+     * Determines if two boxes share at least one point. Boxes touching at the
+     * boundary are considered intersecting.
+     */
+    template<typename K>
+    constexpr
+    bool intersects(box<K> const& a, box<K> const& b) noexcept;
+
+    /**
+     * Returns the smallest box containing both boxes.
+     */
+    template<typename K>
+    constexpr
+    box<K> merge(box<K> const& a, box<K> const& b) noexcept;
+
+    /**
+     * Returns the box itself. This function exists for symmetry with the
+     * bounding_box() function of other shapes.
+     */
+    template<typename K>
+    constexpr
+    box<K> bounding_box(box<K> const& b) noexcept;
 }
 
 #include "box.ipp"
@@ -74,4 +74,95 @@ namespace geo
         }
         return vol;
     }
+
+    // Analytic query ----------------------------------------------------------
+
+    template<typename K>
+    auto box<K>::potential(point_type const& p) const noexcept -> metric_type
+    {
+        return oriented_distance(p);
+    }
+
+    template<typename K>
+    auto box<K>::oriented_distance(point_type const& p) const noexcept -> metric_type
+    {
+        // Outside, the distance to the box. Inside, minus the distance to the
+        // nearest face.
+        scalar_type depth = detail::unbounded_value<scalar_type>();
+        for (unsigned i = 0; i < dimension; ++i) {
+            depth = std::min({depth, p[i] - lowest_vertex_[i],
+                                     highest_vertex_[i] - p[i]});
+        }
+        if (depth >= 0) {
+            return -depth;
+        }
+        return K::sqrt(squared_distance(*this, p));
+    }
+
+    // Basic operations --------------------------------------------------------
+
+    template<typename K>
+    constexpr
+    typename K::metric squared_distance(box<K> const& b,
+                                        point<K> const& p) noexcept
+    {
+        using scalar_type = typename K::scalar;
+
+        point<K> const low = b.lowest_vertex();
+        point<K> const high = b.highest_vertex();
+
+        vector<K> excess;
+        for (unsigned i = 0; i < K::dimension; ++i) {
+            excess[i] = std::max({low[i] - p[i], p[i] - high[i], scalar_type(0)});
+        }
+        return squared_norm(excess);
+    }
+
+    template<typename K>
+    constexpr
+    typename K::metric squared_distance(point<K> const& p,
+                                        box<K> const& b) noexcept
+    {
+        return squared_distance(b, p);
+    }
+
+    template<typename K>
+    constexpr
+    bool intersects(box<K> const& a, box<K> const& b) noexcept
+    {
+        point<K> const a_low = a.lowest_vertex();
+        point<K> const a_high = a.highest_vertex();
+        point<K> const b_low = b.lowest_vertex();
+        point<K> const b_high = b.highest_vertex();
+
+        // Bitwise and avoids a branch per axis.
+        bool overlap = true;
+        for (unsigned i = 0; i < K::dimension; ++i) {
+            overlap &= (a_low[i] <= b_high[i]) & (b_low[i] <= a_high[i]);
+        }
+        return overlap;
+    }
+
+    template<typename K>
+    constexpr
+    box<K> merge(box<K> const& a, box<K> const& b) noexcept
+    {
+        point<K> low = a.lowest_vertex();
+        point<K> high = a.highest_vertex();
+        point<K> const b_low = b.lowest_vertex();
+        point<K> const b_high = b.highest_vertex();
+
+        for (unsigned i = 0; i < K::dimension; ++i) {
+            low[i] = std::min(low[i], b_low[i]);
+            high[i] = std::max(high[i], b_high[i]);
+        }
+        return box<K>{low, high};
+    }
+
+    template<typename K>
+    constexpr
+    box<K> bounding_box(box<K> const& b) noexcept
+    {
+        return b;
+    }
 }
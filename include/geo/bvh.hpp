@@ -0,0 +1,203 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Bounding volume hierarchy of shapes.
+//
+
+#ifndef GEO_BVH_HPP
+#define GEO_BVH_HPP
+
+#include <cstddef>
+#include <type_traits>
+#include <vector>
+
+#include "box.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    template<typename K>
+    struct sphere;
+
+    template<typename K>
+    struct oriented_box;
+
+    /**
+     * Trait telling whether the oriented_distance() member function of Shape
+     * gives the exact distance to its surface. The distance to the bounding
+     * box of such a shape never exceeds the absolute value of its oriented
+     * distance, which lets bvh::nearest_surface() prune by bounding boxes.
+     *
+     * Specialize it to std::true_type for other shapes with exact distances.
+     */
+    template<typename Shape>
+    struct has_exact_oriented_distance : std::false_type
+    {
+    };
+
+    template<typename K>
+    struct has_exact_oriented_distance<box<K>> : std::true_type
+    {
+    };
+
+    template<typename K>
+    struct has_exact_oriented_distance<sphere<K>> : std::true_type
+    {
+    };
+
+    template<typename K>
+    struct has_exact_oriented_distance<oriented_box<K>> : std::true_type
+    {
+    };
+
+    /**
+     * Bounding volume hierarchy over shapes like sphere, ellipsoid and box.
+     *
+     * The Shape type must define kernel and metric_type, provide potential()
+     * and oriented_distance() member functions and have a bounding_box()
+     * function found by argument-dependent lookup.
+     *
+     * The hierarchy is built once with the binned surface area heuristic on
+     * the bounding boxes of the shapes. Nodes are stored in a flat array in
+     * depth-first order: the left child of a node immediately follows it and
+     * the right child is referred to by index.
+     *
+     * Shapes are identified by their index in the range the hierarchy was
+     * built from.
+     */
+    template<typename Shape>
+    struct bvh
+    {
+        /**
+         * Alias to the template parameter Shape.
+         */
+        using shape_type = Shape;
+
+        /**
+         * Kernel of the shapes.
+         */
+        using kernel = typename Shape::kernel;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename kernel::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename kernel::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<kernel>;
+
+        /**
+         * Type of bounding volumes.
+         */
+        using box_type = box<kernel>;
+
+        /**
+         * Type for indices of shapes.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = kernel::dimension;
+
+        /**
+         * Number of shapes at or below which a node is always a leaf. A node
+         * of up to twice as many shapes is also a leaf if the surface area
+         * heuristic finds no split cheaper than keeping it whole, so leaves
+         * hold at most 2 * leaf_size shapes.
+         */
+        static constexpr std::size_t leaf_size = 4;
+
+        /**
+         * Number of bins used to evaluate candidate splits.
+         */
+        static constexpr unsigned bin_count = 16;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty hierarchy.
+         */
+        bvh() = default;
+
+        /**
+         * Builds a hierarchy of shapes in given range.
+         */
+        template<typename Iterator>
+        bvh(Iterator first, Iterator last);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of shapes.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if the hierarchy has no shape.
+         */
+        bool empty() const noexcept;
+
+        // Query ---------------------------------------------------------------
+
+        /**
+         * Writes the indices of shapes containing p, that is, shapes whose
+         * potential at p is not positive. Indices are written in unspecified
+         * order. Returns the end of the output range.
+         */
+        template<typename OutputIterator>
+        OutputIterator containing(point_type const& p, OutputIterator out) const;
+
+        /**
+         * Writes the indices of shapes whose bounding boxes intersect given
+         * box. Indices are written in unspecified order. Returns the end of
+         * the output range.
+         */
+        template<typename OutputIterator>
+        OutputIterator overlapping(box_type const& b, OutputIterator out) const;
+
+        /**
+         * Returns the index of the shape whose surface is nearest to p as
+         * measured by the absolute value of exact_oriented_distance() if the
+         * shape has it, like ellipsoid, and of oriented_distance() otherwise.
+         *
+         * Subtrees are pruned by the distance to their bounding boxes, which
+         * is only valid if the measured distance is never smaller than the
+         * distance to the bounding box of the shape. That holds for exact
+         * distances, so subtrees are pruned only if the shape has member
+         * function exact_oriented_distance() or has_exact_oriented_distance
+         * is true for it. Otherwise every shape is visited. Assertion fails
+         * if the hierarchy is empty.
+         */
+        index_type nearest_surface(point_type const& p) const;
+
+      private:
+        struct node
+        {
+            box_type bounds;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t right;
+        };
+
+        std::size_t build(std::vector<box_type> const& boxes,
+                          std::size_t begin, std::size_t end);
+
+        std::vector<node> nodes_;
+        std::vector<index_type> indices_;
+        std::vector<shape_type> shapes_;
+    };
+}
+
+#include "bvh.ipp"
+
+#endif
@@ -0,0 +1,381 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "bvh.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Surface measure of box used by the surface area heuristic: the sum
+        // over axes of the product of the other sides. This is half of the
+        // surface area in three dimensions and the half perimeter in two.
+        template<typename K>
+        typename K::metric surface_measure(box<K> const& b) noexcept
+        {
+            auto const span = b.diagonal_span();
+            typename K::metric measure = 0;
+            for (unsigned i = 0; i < K::dimension; ++i) {
+                typename K::metric face = 1;
+                for (unsigned j = 0; j < K::dimension; ++j) {
+                    if (j != i) {
+                        face *= span[j];
+                    }
+                }
+                measure += face;
+            }
+            return measure;
+        }
+
+        // Whether Shape has member function exact_oriented_distance().
+        template<typename Shape, typename = void>
+        struct has_exact_distance_member : std::false_type
+        {
+        };
+
+        template<typename Shape>
+        struct has_exact_distance_member<
+            Shape,
+            decltype(void(std::declval<Shape const&>().exact_oriented_distance(
+                std::declval<point<typename Shape::kernel> const&>())))
+        > : std::true_type
+        {
+        };
+
+        // Distance from p to the surface of shape measured by nearest_surface.
+        template<typename Shape>
+        typename Shape::metric_type
+        surface_distance(Shape const& shape,
+                         point<typename Shape::kernel> const& p,
+                         std::true_type)
+        {
+            return std::abs(shape.exact_oriented_distance(p));
+        }
+
+        template<typename Shape>
+        typename Shape::metric_type
+        surface_distance(Shape const& shape,
+                         point<typename Shape::kernel> const& p,
+                         std::false_type)
+        {
+            return std::abs(shape.oriented_distance(p));
+        }
+
+        // Accumulated bounds of the shapes falling into a bin.
+        template<typename K>
+        struct bvh_bin
+        {
+            box<K> bounds;
+            std::size_t count = 0;
+
+            void add(box<K> const& b) noexcept
+            {
+                bounds = count == 0 ? b : merge(bounds, b);
+                count++;
+            }
+
+            void add(bvh_bin const& other) noexcept
+            {
+                if (other.count != 0) {
+                    bounds = count == 0 ? other.bounds : merge(bounds, other.bounds);
+                    count += other.count;
+                }
+            }
+        };
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename Shape>
+    template<typename Iterator>
+    bvh<Shape>::bvh(Iterator first, Iterator last)
+        : shapes_(first, last)
+    {
+        if (shapes_.empty()) {
+            return;
+        }
+
+        std::vector<box_type> boxes;
+        boxes.reserve(shapes_.size());
+        for (shape_type const& shape : shapes_) {
+            boxes.push_back(bounding_box(shape));
+        }
+
+        indices_.resize(shapes_.size());
+        std::iota(indices_.begin(), indices_.end(), index_type(0));
+        nodes_.reserve(2 * shapes_.size() / leaf_size + 1);
+        build(boxes, 0, shapes_.size());
+
+        // Store shapes in leaf order so that leaf scans are sequential.
+        std::vector<shape_type> ordered;
+        ordered.reserve(shapes_.size());
+        for (index_type const idx : indices_) {
+            ordered.push_back(shapes_[idx]);
+        }
+        shapes_.swap(ordered);
+    }
+
+    template<typename Shape>
+    std::size_t bvh<Shape>::build(std::vector<box_type> const& boxes,
+                                  std::size_t begin, std::size_t end)
+    {
+        box_type bounds = boxes[indices_[begin]];
+        point_type const first_center = bounds.center();
+        point_type center_low = first_center;
+        point_type center_high = first_center;
+
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            box_type const& b = boxes[indices_[i]];
+            point_type const center = b.center();
+            bounds = merge(bounds, b);
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                center_low[axis] = std::min(center_low[axis], center[axis]);
+                center_high[axis] = std::max(center_high[axis], center[axis]);
+            }
+        }
+
+        std::size_t const self = nodes_.size();
+        nodes_.push_back(node {bounds, begin, end, 0});
+
+        std::size_t const count = end - begin;
+        if (count <= leaf_size) {
+            return self;
+        }
+
+        auto const center_span = center_high - center_low;
+        unsigned split_axis = 0;
+        for (unsigned axis = 1; axis < dimension; ++axis) {
+            if (center_span[axis] > center_span[split_axis]) {
+                split_axis = axis;
+            }
+        }
+
+        scalar_type const axis_low = center_low[split_axis];
+        scalar_type const axis_span = center_span[split_axis];
+        std::size_t mid = begin + count / 2;
+
+        if (axis_span > 0) {
+            auto const bin_of = [&](std::size_t index) {
+                scalar_type const offset = boxes[index].center()[split_axis] - axis_low;
+                auto const bin = static_cast<unsigned>(offset / axis_span * bin_count);
+                return std::min(bin, bin_count - 1);
+            };
+
+            detail::bvh_bin<kernel> bins[bin_count];
+            for (std::size_t i = begin; i < end; ++i) {
+                bins[bin_of(indices_[i])].add(boxes[indices_[i]]);
+            }
+
+            // Sweep from the right to get the cost of the right side of each
+            // split plane, then from the left to find the cheapest plane.
+            metric_type right_cost[bin_count] {};
+            detail::bvh_bin<kernel> accum;
+            for (unsigned split = bin_count - 1; split > 0; --split) {
+                accum.add(bins[split]);
+                right_cost[split] = accum.count == 0 ? metric_type(0)
+                    : detail::surface_measure(accum.bounds) * metric_type(accum.count);
+            }
+
+            metric_type best_cost = std::numeric_limits<metric_type>::infinity();
+            unsigned best_split = 0;
+            accum = detail::bvh_bin<kernel> {};
+            for (unsigned split = 1; split < bin_count; ++split) {
+                accum.add(bins[split - 1]);
+                if (accum.count == 0 || accum.count == count) {
+                    continue;
+                }
+                metric_type const cost =
+                    detail::surface_measure(accum.bounds) * metric_type(accum.count) +
+                    right_cost[split];
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best_split = split;
+                }
+            }
+
+            metric_type const leaf_cost =
+                detail::surface_measure(bounds) * metric_type(count);
+            if (best_split == 0 || best_cost >= leaf_cost) {
+                if (count <= 2 * leaf_size) {
+                    return self;
+                }
+            }
+
+            if (best_split != 0) {
+                auto const pivot = std::partition(
+                    indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+                    indices_.begin() + static_cast<std::ptrdiff_t>(end),
+                    [&](index_type index) { return bin_of(index) < best_split; }
+                );
+                mid = static_cast<std::size_t>(pivot - indices_.begin());
+            }
+        }
+
+        build(boxes, begin, mid);
+        std::size_t const right = build(boxes, mid, end);
+        nodes_[self].right = right;
+
+        return self;
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename Shape>
+    std::size_t bvh<Shape>::size() const noexcept
+    {
+        return shapes_.size();
+    }
+
+    template<typename Shape>
+    bool bvh<Shape>::empty() const noexcept
+    {
+        return shapes_.empty();
+    }
+
+    // Query -------------------------------------------------------------------
+
+    // A node is a leaf if it has no right child. The root is never a right
+    // child, so zero works as the sentinel.
+
+    template<typename Shape>
+    template<typename OutputIterator>
+    OutputIterator bvh<Shape>::containing(point_type const& p,
+                                          OutputIterator out) const
+    {
+        if (empty()) {
+            return out;
+        }
+
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            std::size_t const index = stack.back();
+            stack.pop_back();
+
+            node const& current = nodes_[index];
+            if (squared_distance(current.bounds, p) > 0) {
+                continue;
+            }
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    if (shapes_[i].potential(p) <= 0) {
+                        *out++ = indices_[i];
+                    }
+                }
+                continue;
+            }
+
+            stack.push_back(current.right);
+            stack.push_back(index + 1);
+        }
+
+        return out;
+    }
+
+    template<typename Shape>
+    template<typename OutputIterator>
+    OutputIterator bvh<Shape>::overlapping(box_type const& b,
+                                           OutputIterator out) const
+    {
+        if (empty()) {
+            return out;
+        }
+
+        std::vector<std::size_t> stack {0};
+        while (!stack.empty()) {
+            std::size_t const index = stack.back();
+            stack.pop_back();
+
+            node const& current = nodes_[index];
+            if (!intersects(current.bounds, b)) {
+                continue;
+            }
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    if (intersects(bounding_box(shapes_[i]), b)) {
+                        *out++ = indices_[i];
+                    }
+                }
+                continue;
+            }
+
+            stack.push_back(current.right);
+            stack.push_back(index + 1);
+        }
+
+        return out;
+    }
+
+    template<typename Shape>
+    auto bvh<Shape>::nearest_surface(point_type const& p) const -> index_type
+    {
+        GEO_ASSERT(!empty());
+
+        using exact_member = detail::has_exact_distance_member<shape_type>;
+        using entry = std::pair<std::size_t, metric_type>;
+
+        // Without an exact distance, the distance to a bounding box does not
+        // bound the measured distance to the shapes inside from below. Every
+        // box then gets a zero distance so that nothing is pruned.
+        constexpr bool prune =
+            exact_member::value || has_exact_oriented_distance<shape_type>::value;
+        auto const box_distance = [&](std::size_t index) {
+            return prune ? squared_distance(nodes_[index].bounds, p) : metric_type(0);
+        };
+
+        metric_type best_distance = std::numeric_limits<metric_type>::infinity();
+        metric_type best_squared = best_distance;
+        std::size_t best = 0;
+
+        std::vector<entry> stack {entry {0, box_distance(0)}};
+        while (!stack.empty()) {
+            entry const top = stack.back();
+            stack.pop_back();
+            if (top.second > best_squared) {
+                continue;
+            }
+
+            node const& current = nodes_[top.first];
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    metric_type const distance =
+                        detail::surface_distance(shapes_[i], p, exact_member {});
+                    if (distance < best_distance) {
+                        best_distance = distance;
+                        best_squared = distance * distance;
+                        best = i;
+                    }
+                }
+                continue;
+            }
+
+            entry near {top.first + 1, box_distance(top.first + 1)};
+            entry far {current.right, box_distance(current.right)};
+            if (far.second < near.second) {
+                std::swap(near, far);
+            }
+            if (far.second <= best_squared) {
+                stack.push_back(far);
+            }
+            if (near.second <= best_squared) {
+                stack.push_back(near);
+            }
+        }
+
+        return indices_[best];
+    }
+}
@@ -0,0 +1,166 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Uniform grid for fixed-cutoff neighbor search.
+//
+
+#ifndef GEO_CELL_LIST_HPP
+#define GEO_CELL_LIST_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "box.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    /**
+     * Uniform grid of cubic cells over a box domain.
+     *
+     * Points are bucketed into cells of given width and stored sorted by
+     * cell, so every cell is a contiguous range of points. Neighbor search
+     * visits only the cells that may contain points within a cutoff
+     * distance, which makes enumeration of close pairs roughly linear in the
+     * number of points.
+     *
+     * Points are identified by their index in the range the cell list was
+     * built from. Points outside the domain are put into the boundary cells,
+     * so queries give correct results for them (at a cost of crowding the
+     * boundary cells).
+     */
+    template<typename K>
+    struct cell_list
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type of the domain.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Type for indices of points.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        /**
+         * Number of cells per point allowed in the grid.
+         */
+        static constexpr std::size_t max_cells_per_point = 4;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty cell list.
+         */
+        cell_list() = default;
+
+        /**
+         * Builds a cell list of points in given range.
+         *
+         * The domain is divided into cells whose edges are at least
+         * cell_width long. Queries are fastest when the cutoff distance is
+         * equal to or slightly less than cell_width. Assertion fails if
+         * cell_width is not positive.
+         *
+         * The grid has at most max_cell_count(n) cells for n points. If the
+         * domain is too large for that many cells of given width, as with a
+         * sparse point set or a far outlier, the cells are widened. Queries
+         * stay correct but visit more points.
+         */
+        template<typename Iterator>
+        cell_list(Iterator first, Iterator last,
+                  box_type const& domain, metric_type cell_width);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of points.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns the domain.
+         */
+        box_type domain() const noexcept;
+
+        /**
+         * Returns the number of cells.
+         */
+        std::size_t cell_count() const noexcept;
+
+        /**
+         * Returns the maximum number of cells of a grid over given number of
+         * points, that is, max_cells_per_point times the number of points
+         * but at least one.
+         */
+        static std::size_t max_cell_count(std::size_t point_count) noexcept;
+
+        // Query ---------------------------------------------------------------
+
+        /**
+         * Calls fn(i, j, d2) for every pair of points whose squared distance
+         * d2 is less than or equal to cutoff^2.
+         *
+         * Each unordered pair is visited exactly once and i != j. The order of
+         * i and j within a pair is unspecified.
+         */
+        template<typename Fn>
+        void for_each_pair_within(metric_type cutoff, Fn fn) const;
+
+        /**
+         * Calls fn(i, d2) for every point whose squared distance d2 from p is
+         * less than or equal to cutoff^2.
+         *
+         * If p is one of the stored points, fn is called for it as well with
+         * d2 equal to zero.
+         */
+        template<typename Fn>
+        void for_each_neighbor(point_type const& p, metric_type cutoff, Fn fn) const;
+
+      private:
+        using cell_index = long;
+
+        cell_index locate(point_type const& p, unsigned axis) const noexcept;
+
+        std::size_t linear_cell(cell_index const* cell) const noexcept;
+
+        cell_index reach(metric_type cutoff, unsigned axis) const noexcept;
+
+        box_type domain_;
+        metric_type cell_width_ {};
+        cell_index grid_[dimension] {};
+        std::vector<std::size_t> cell_begin_;
+        std::vector<index_type> indices_;
+        std::vector<point_type> points_;
+    };
+}
+
+#include "cell_list.ipp"
+
+#endif
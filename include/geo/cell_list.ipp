@@ -0,0 +1,287 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "cell_list.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    template<typename Iterator>
+    cell_list<K>::cell_list(Iterator first, Iterator last,
+                            box_type const& domain, metric_type cell_width)
+        : domain_ {domain}
+        , cell_width_ {cell_width}
+    {
+        GEO_ASSERT(cell_width > 0);
+
+        std::vector<point_type> points(first, last);
+
+        // Widen the cells until the grid is small enough. Cell counts are
+        // computed in floating point so that they cannot overflow. If the
+        // scaled width does not grow due to rounding, it is doubled.
+        auto const span = domain.diagonal_span();
+        double const max_cells = double(max_cell_count(points.size()));
+        double grid[dimension];
+        for (;;) {
+            double cells = 1;
+            for (unsigned i = 0; i < dimension; ++i) {
+                grid[i] = std::max(1.0, std::ceil(double(span[i]) / double(cell_width_)));
+                cells *= grid[i];
+            }
+            if (cells <= max_cells) {
+                break;
+            }
+            double const factor = std::pow(cells / max_cells, 1.0 / dimension);
+            auto const wider = static_cast<metric_type>(double(cell_width_) * factor);
+            cell_width_ = wider > cell_width_ ? wider : cell_width_ * metric_type(2);
+        }
+
+        std::size_t cell_count = 1;
+        for (unsigned i = 0; i < dimension; ++i) {
+            grid_[i] = static_cast<cell_index>(grid[i]);
+            cell_count *= static_cast<std::size_t>(grid_[i]);
+        }
+
+        std::vector<std::size_t> cells(points.size());
+        for (std::size_t idx = 0; idx < points.size(); ++idx) {
+            cell_index cell[dimension];
+            for (unsigned i = 0; i < dimension; ++i) {
+                cell[i] = locate(points[idx], i);
+            }
+            cells[idx] = linear_cell(cell);
+        }
+
+        // Counting sort by cell.
+        cell_begin_.assign(cell_count + 1, 0);
+        for (std::size_t const cell : cells) {
+            cell_begin_[cell + 1]++;
+        }
+        std::partial_sum(cell_begin_.begin(), cell_begin_.end(), cell_begin_.begin());
+
+        std::vector<std::size_t> cursor(cell_begin_.begin(), cell_begin_.end() - 1);
+        indices_.resize(points.size());
+        points_.resize(points.size());
+        for (std::size_t idx = 0; idx < points.size(); ++idx) {
+            std::size_t const pos = cursor[cells[idx]]++;
+            indices_[pos] = idx;
+            points_[pos] = points[idx];
+        }
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    std::size_t cell_list<K>::size() const noexcept
+    {
+        return points_.size();
+    }
+
+    template<typename K>
+    auto cell_list<K>::domain() const noexcept -> box_type
+    {
+        return domain_;
+    }
+
+    template<typename K>
+    std::size_t cell_list<K>::cell_count() const noexcept
+    {
+        return cell_begin_.empty() ? 0 : cell_begin_.size() - 1;
+    }
+
+    template<typename K>
+    std::size_t cell_list<K>::max_cell_count(std::size_t point_count) noexcept
+    {
+        return std::max(max_cells_per_point * point_count, std::size_t(1));
+    }
+
+    // Internals ---------------------------------------------------------------
+
+    template<typename K>
+    auto cell_list<K>::locate(point_type const& p, unsigned axis) const noexcept
+    -> cell_index
+    {
+        // Clamp before conversion as points far outside the domain may have
+        // offsets out of the range of cell_index.
+        double const offset =
+            double(p[axis] - domain_.lowest_vertex()[axis]) / double(cell_width_);
+        double const cell = std::min(std::max(std::floor(offset), 0.0),
+                                     double(grid_[axis] - 1));
+        return static_cast<cell_index>(cell);
+    }
+
+    template<typename K>
+    std::size_t cell_list<K>::linear_cell(cell_index const* cell) const noexcept
+    {
+        std::size_t linear = 0;
+        for (unsigned i = 0; i < dimension; ++i) {
+            linear = linear * static_cast<std::size_t>(grid_[i]) +
+                     static_cast<std::size_t>(cell[i]);
+        }
+        return linear;
+    }
+
+    template<typename K>
+    auto cell_list<K>::reach(metric_type cutoff, unsigned axis) const noexcept
+    -> cell_index
+    {
+        // Points within cutoff are at most ceil(cutoff / width) cells apart
+        // along every axis, and no cells are further apart than the grid is
+        // long. Clamp before conversion as the cutoff may be huge or infinite.
+        double const cells = std::ceil(double(cutoff) / double(cell_width_));
+        return static_cast<cell_index>(std::min(cells, double(grid_[axis] - 1)));
+    }
+
+    // Query -------------------------------------------------------------------
+
+    template<typename K>
+    template<typename Fn>
+    void cell_list<K>::for_each_pair_within(metric_type cutoff, Fn fn) const
+    {
+        GEO_ASSERT(cutoff >= 0);
+
+        if (points_.empty()) {
+            return;
+        }
+
+        metric_type const squared_cutoff = cutoff * cutoff;
+        cell_index r[dimension];
+        for (unsigned i = 0; i < dimension; ++i) {
+            r[i] = std::min(std::max(reach(cutoff, i), cell_index(1)), grid_[i] - 1);
+        }
+
+        // Half stencil: offsets whose first nonzero component is positive.
+        // Together with the pairs within a cell, this visits every pair of
+        // neighbor cells exactly once.
+        std::vector<cell_index> stencil;
+        cell_index offset[dimension];
+        for (unsigned i = 0; i < dimension; ++i) {
+            offset[i] = -r[i];
+        }
+        for (;;) {
+            unsigned lead = 0;
+            while (lead < dimension && offset[lead] == 0) {
+                ++lead;
+            }
+            if (lead < dimension && offset[lead] > 0) {
+                stencil.insert(stencil.end(), offset, offset + dimension);
+            }
+
+            unsigned axis = dimension;
+            while (axis > 0 && offset[axis - 1] == r[axis - 1]) {
+                --axis;
+                offset[axis] = -r[axis];
+            }
+            if (axis == 0) {
+                break;
+            }
+            ++offset[axis - 1];
+        }
+
+        cell_index cell[dimension] {};
+        for (std::size_t linear = 0; linear < cell_count(); ++linear) {
+            std::size_t const begin = cell_begin_[linear];
+            std::size_t const end = cell_begin_[linear + 1];
+
+            if (begin != end) {
+                for (std::size_t a = begin; a < end; ++a) {
+                    for (std::size_t b = a + 1; b < end; ++b) {
+                        auto const d2 = squared_distance(points_[a], points_[b]);
+                        if (d2 <= squared_cutoff) {
+                            fn(indices_[a], indices_[b], d2);
+                        }
+                    }
+                }
+
+                for (std::size_t s = 0; s < stencil.size(); s += dimension) {
+                    cell_index neighbor[dimension];
+                    bool inside = true;
+                    for (unsigned i = 0; i < dimension; ++i) {
+                        neighbor[i] = cell[i] + stencil[s + i];
+                        inside = inside && neighbor[i] >= 0 && neighbor[i] < grid_[i];
+                    }
+                    if (!inside) {
+                        continue;
+                    }
+
+                    std::size_t const other = linear_cell(neighbor);
+                    std::size_t const other_begin = cell_begin_[other];
+                    std::size_t const other_end = cell_begin_[other + 1];
+
+                    for (std::size_t a = begin; a < end; ++a) {
+                        for (std::size_t b = other_begin; b < other_end; ++b) {
+                            auto const d2 = squared_distance(points_[a], points_[b]);
+                            if (d2 <= squared_cutoff) {
+                                fn(indices_[a], indices_[b], d2);
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Advance multi-index in the same row-major order as linear_cell.
+            for (unsigned i = dimension; i-- > 0; ) {
+                if (++cell[i] < grid_[i]) {
+                    break;
+                }
+                cell[i] = 0;
+            }
+        }
+    }
+
+    template<typename K>
+    template<typename Fn>
+    void cell_list<K>::for_each_neighbor(point_type const& p,
+                                         metric_type cutoff,
+                                         Fn fn) const
+    {
+        GEO_ASSERT(cutoff >= 0);
+
+        if (points_.empty()) {
+            return;
+        }
+
+        metric_type const squared_cutoff = cutoff * cutoff;
+
+        cell_index lower[dimension];
+        cell_index upper[dimension];
+        for (unsigned i = 0; i < dimension; ++i) {
+            cell_index const center = locate(p, i);
+            cell_index const r = reach(cutoff, i);
+            lower[i] = std::max(center - r, cell_index(0));
+            upper[i] = std::min(center + r, grid_[i] - 1);
+        }
+
+        cell_index cell[dimension];
+        std::copy(lower, lower + dimension, cell);
+        for (;;) {
+            std::size_t const linear = linear_cell(cell);
+            for (std::size_t a = cell_begin_[linear]; a < cell_begin_[linear + 1]; ++a) {
+                auto const d2 = squared_distance(p, points_[a]);
+                if (d2 <= squared_cutoff) {
+                    fn(indices_[a], d2);
+                }
+            }
+
+            unsigned axis = dimension;
+            while (axis > 0 && cell[axis - 1] == upper[axis - 1]) {
+                --axis;
+                cell[axis] = lower[axis];
+            }
+            if (axis == 0) {
+                break;
+            }
+            ++cell[axis - 1];
+        }
+    }
+}
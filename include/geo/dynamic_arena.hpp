@@ -0,0 +1,142 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Block storage of coordinate tuples whose dimension is chosen at run time.
+//
+
+#ifndef GEO_DYNAMIC_ARENA_HPP
+#define GEO_DYNAMIC_ARENA_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "dynamic_point.hpp"
+#include "dynamic_vector.hpp"
+#include "internal/aligned_allocator.hpp"
+
+namespace geo
+{
+    /**
+     * Append-only storage of coordinate tuples of a dimension fixed at
+     * construction, handing out dynamic_point and dynamic_vector views.
+     *
+     * Tuples are stored contiguously in aligned blocks of about 64 KiB, each
+     * tuple padded with zeros to a whole number of 64-byte lines so that
+     * distance and inner product kernels run over whole SIMD registers.
+     * Blocks are never reallocated, so views and pointers to tuples stay
+     * valid as tuples are appended, until the arena is cleared or destroyed.
+     */
+    template<typename K>
+    struct dynamic_arena
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type of point views.
+         */
+        using point_type = dynamic_point<K>;
+
+        /**
+         * Type of vector views.
+         */
+        using vector_type = dynamic_vector<K>;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty arena of tuples of given dimension.
+         */
+        explicit
+        dynamic_arena(unsigned dimension);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the dimension of the tuples.
+         */
+        unsigned dimension() const noexcept;
+
+        /**
+         * Returns the number of scalars stored per tuple including padding.
+         */
+        unsigned stride() const noexcept;
+
+        /**
+         * Returns the number of tuples.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if the arena has no tuples.
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Returns the number of tuples per block. Tuples of a block are
+         * contiguous with stride() scalars between consecutive ones.
+         */
+        std::size_t block_size() const noexcept;
+
+        // Element access ------------------------------------------------------
+
+        /**
+         * Returns the index-th tuple as a point.
+         */
+        point_type point(std::size_t index) const;
+
+        /**
+         * Returns the index-th tuple as a vector.
+         */
+        vector_type vector(std::size_t index) const;
+
+        /**
+         * Returns a pointer to the dimension() scalars of the index-th tuple.
+         * The padding following them must be kept zero.
+         */
+        scalar_type* data(std::size_t index);
+
+        /**
+         * Returns a pointer to the scalars of the index-th tuple.
+         */
+        scalar_type const* data(std::size_t index) const;
+
+        // Modifiers -----------------------------------------------------------
+
+        /**
+         * Appends a tuple with all-zero scalars and returns its index.
+         */
+        std::size_t append();
+
+        /**
+         * Appends a tuple copied from dimension() scalars at coords and
+         * returns its index.
+         */
+        std::size_t append(scalar_type const* coords);
+
+        /**
+         * Removes all tuples. Blocks are kept for reuse, so views obtained
+         * before refer to the tuples appended after.
+         */
+        void clear() noexcept;
+
+      private:
+        unsigned dimension_;
+        unsigned stride_;
+        unsigned block_shift_;
+        std::size_t size_ = 0;
+        std::vector<std::vector<scalar_type, aligned_allocator<scalar_type>>> blocks_;
+    };
+}
+
+#include "dynamic_arena.ipp"
+
+#endif
@@ -0,0 +1,132 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "assert.hpp"
+#include "dynamic_arena.hpp"
+#include "internal/aligned_allocator.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Approximate number of bytes of a block of dynamic_arena.
+        constexpr std::size_t dynamic_arena_block_bytes = std::size_t(1) << 16;
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    // The number of tuples per block is a power of two, so that an index
+    // splits into block and offset by shift and mask.
+    template<typename K>
+    dynamic_arena<K>::dynamic_arena(unsigned dimension)
+        : dimension_ {dimension}
+    {
+        GEO_ASSERT(dimension >= 1);
+
+        constexpr unsigned line = simd_alignment / sizeof(scalar_type);
+        stride_ = (dimension + line - 1) / line * line;
+
+        std::size_t const tuple_bytes = stride_ * sizeof(scalar_type);
+        block_shift_ = 0;
+        while ((tuple_bytes << (block_shift_ + 1)) <= detail::dynamic_arena_block_bytes) {
+            block_shift_++;
+        }
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    unsigned dynamic_arena<K>::dimension() const noexcept
+    {
+        return dimension_;
+    }
+
+    template<typename K>
+    unsigned dynamic_arena<K>::stride() const noexcept
+    {
+        return stride_;
+    }
+
+    template<typename K>
+    std::size_t dynamic_arena<K>::size() const noexcept
+    {
+        return size_;
+    }
+
+    template<typename K>
+    bool dynamic_arena<K>::empty() const noexcept
+    {
+        return size_ == 0;
+    }
+
+    template<typename K>
+    std::size_t dynamic_arena<K>::block_size() const noexcept
+    {
+        return std::size_t(1) << block_shift_;
+    }
+
+    // Element access ----------------------------------------------------------
+
+    template<typename K>
+    auto dynamic_arena<K>::point(std::size_t index) const -> point_type
+    {
+        return point_type {data(index), dimension_, stride_};
+    }
+
+    template<typename K>
+    auto dynamic_arena<K>::vector(std::size_t index) const -> vector_type
+    {
+        return vector_type {data(index), dimension_, stride_};
+    }
+
+    template<typename K>
+    auto dynamic_arena<K>::data(std::size_t index) -> scalar_type*
+    {
+        GEO_ASSERT(index < size_);
+        std::size_t const offset = index & (block_size() - 1);
+        return blocks_[index >> block_shift_].data() + offset * stride_;
+    }
+
+    template<typename K>
+    auto dynamic_arena<K>::data(std::size_t index) const -> scalar_type const*
+    {
+        GEO_ASSERT(index < size_);
+        std::size_t const offset = index & (block_size() - 1);
+        return blocks_[index >> block_shift_].data() + offset * stride_;
+    }
+
+    // Modifiers ---------------------------------------------------------------
+
+    template<typename K>
+    std::size_t dynamic_arena<K>::append()
+    {
+        std::size_t const index = size_;
+        std::size_t const block = index >> block_shift_;
+        if (block == blocks_.size()) {
+            blocks_.emplace_back(block_size() * stride_);
+        }
+
+        size_++;
+        scalar_type* const coords = data(index);
+        std::fill(coords, coords + stride_, scalar_type(0));
+        return index;
+    }
+
+    template<typename K>
+    std::size_t dynamic_arena<K>::append(scalar_type const* coords)
+    {
+        std::size_t const index = append();
+        std::copy(coords, coords + dimension_, data(index));
+        return index;
+    }
+
+    template<typename K>
+    void dynamic_arena<K>::clear() noexcept
+    {
+        size_ = 0;
+    }
+}
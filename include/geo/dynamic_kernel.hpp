@@ -0,0 +1,54 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Kernel of spaces whose dimension is chosen at run time.
+//
+// This header has no inline implementation file (*.ipp).
+//
+
+#ifndef GEO_DYNAMIC_KERNEL_HPP
+#define GEO_DYNAMIC_KERNEL_HPP
+
+#include <cmath>
+#include <type_traits>
+
+namespace geo
+{
+    /**
+     * Kernel for coordinate tuples whose dimension is known at run time
+     * only, stored as builtin floating point type T and measured in M, which
+     * is T or a wider type.
+     *
+     * The kernel has no dimension member, so it does not work with point,
+     * vector and the shapes. It is used with dynamic_point, dynamic_vector
+     * and dynamic_arena, which carry the dimension as a value.
+     */
+    template<typename T, typename M = T>
+    struct dynamic_kernel
+    {
+        static_assert(std::is_floating_point<T>::value, "");
+        static_assert(std::is_floating_point<M>::value, "");
+        static_assert(sizeof(T) <= sizeof(M), "");
+
+        /**
+         * Aliased to T.
+         */
+        using scalar = T;
+
+        /**
+         * Aliased to M.
+         */
+        using metric = M;
+
+        /**
+         * Calls std::sqrt(x).
+         */
+        static metric sqrt(metric x) noexcept
+        {
+            return std::sqrt(x);
+        }
+    };
+}
+
+#endif
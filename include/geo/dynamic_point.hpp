@@ -0,0 +1,71 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// View of a point whose dimension is chosen at run time.
+//
+
+#ifndef GEO_DYNAMIC_POINT_HPP
+#define GEO_DYNAMIC_POINT_HPP
+
+#include "internal/basic_dynamic_coordinates.hpp"
+
+namespace geo
+{
+    /**
+     * Read-only view of the coordinates of a point stored elsewhere, usually
+     * in a dynamic_arena. Copying the view does not copy the coordinates.
+     *
+     * Coordinates can be accessed as range given by begin() and end() member
+     * functions or directly via indexing operator. dimension() gives the
+     * number of coordinates.
+     */
+    template<typename K>
+    struct dynamic_point : basic_dynamic_coordinates<dynamic_point<K>, K>
+    {
+        using mixin = basic_dynamic_coordinates<dynamic_point<K>, K>;
+
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance, which may be wider than scalar_type.
+         */
+        using metric_type = typename K::metric;
+
+        // Creation ------------------------------------------------------------
+
+        using mixin::mixin;
+    };
+
+    // Basic operations --------------------------------------------------------
+
+    /**
+     * Computes the squared Euclidean distance between points of the same
+     * dimension.
+     *
+     * The sum runs over whole SIMD registers, so the cost depends on the
+     * register width rather than on unrolling by the dimension.
+     */
+    template<typename K>
+    typename K::metric squared_distance(dynamic_point<K> const& p,
+                                        dynamic_point<K> const& q) noexcept;
+
+    /**
+     * Computes the Euclidean distance between points using K::sqrt().
+     */
+    template<typename K>
+    typename K::metric distance(dynamic_point<K> const& p,
+                                dynamic_point<K> const& q) noexcept;
+}
+
+#include "dynamic_point.ipp"
+
+#endif
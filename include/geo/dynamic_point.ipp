@@ -0,0 +1,33 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+
+#include "assert.hpp"
+#include "dynamic_point.hpp"
+#include "internal/simd.hpp"
+
+namespace geo
+{
+    // Basic operations --------------------------------------------------------
+
+    // Differences of zero padding lanes are zero, as in inner_product() of
+    // dynamic_vector.
+
+    template<typename K>
+    typename K::metric squared_distance(dynamic_point<K> const& p,
+                                        dynamic_point<K> const& q) noexcept
+    {
+        GEO_ASSERT(p.dimension() == q.dimension());
+        return detail::simd_squared_distance<typename K::scalar, typename K::metric>(
+            p.data(), q.data(), std::min(p.lanes(), q.lanes())
+        );
+    }
+
+    template<typename K>
+    typename K::metric distance(dynamic_point<K> const& p,
+                                dynamic_point<K> const& q) noexcept
+    {
+        return K::sqrt(squared_distance(p, q));
+    }
+}
@@ -0,0 +1,75 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// View of a vector whose dimension is chosen at run time.
+//
+
+#ifndef GEO_DYNAMIC_VECTOR_HPP
+#define GEO_DYNAMIC_VECTOR_HPP
+
+#include "internal/basic_dynamic_coordinates.hpp"
+
+namespace geo
+{
+    /**
+     * Read-only view of the components of a vector stored elsewhere, usually
+     * in a dynamic_arena. Copying the view does not copy the components.
+     *
+     * Components can be accessed as range given by begin() and end() member
+     * functions or directly via indexing operator. dimension() gives the
+     * number of components.
+     */
+    template<typename K>
+    struct dynamic_vector : basic_dynamic_coordinates<dynamic_vector<K>, K>
+    {
+        using mixin = basic_dynamic_coordinates<dynamic_vector<K>, K>;
+
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for inner products, which may be wider than scalar_type.
+         */
+        using metric_type = typename K::metric;
+
+        // Creation ------------------------------------------------------------
+
+        using mixin::mixin;
+    };
+
+    // Basic operations --------------------------------------------------------
+
+    /**
+     * Computes the inner product of two vectors of the same dimension.
+     *
+     * The sum runs over whole SIMD registers, so the cost depends on the
+     * register width rather than on unrolling by the dimension.
+     */
+    template<typename K>
+    typename K::metric inner_product(dynamic_vector<K> const& u,
+                                     dynamic_vector<K> const& v) noexcept;
+
+    /**
+     * Computes the squared Euclidean norm of vector.
+     */
+    template<typename K>
+    typename K::metric squared_norm(dynamic_vector<K> const& v) noexcept;
+
+    /**
+     * Computes the Euclidean norm of vector using K::sqrt().
+     */
+    template<typename K>
+    typename K::metric norm(dynamic_vector<K> const& v) noexcept;
+}
+
+#include "dynamic_vector.ipp"
+
+#endif
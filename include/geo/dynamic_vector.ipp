@@ -0,0 +1,39 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+
+#include "assert.hpp"
+#include "dynamic_vector.hpp"
+#include "internal/simd.hpp"
+
+namespace geo
+{
+    // Basic operations --------------------------------------------------------
+
+    // Padding lanes are zero and do not change the sums, so the kernels run
+    // over the lanes shared by both views and need no tail when the views
+    // come from the same arena.
+
+    template<typename K>
+    typename K::metric inner_product(dynamic_vector<K> const& u,
+                                     dynamic_vector<K> const& v) noexcept
+    {
+        GEO_ASSERT(u.dimension() == v.dimension());
+        return detail::simd_inner_product<typename K::scalar, typename K::metric>(
+            u.data(), v.data(), std::min(u.lanes(), v.lanes())
+        );
+    }
+
+    template<typename K>
+    typename K::metric squared_norm(dynamic_vector<K> const& v) noexcept
+    {
+        return inner_product(v, v);
+    }
+
+    template<typename K>
+    typename K::metric norm(dynamic_vector<K> const& v) noexcept
+    {
+        return K::sqrt(squared_norm(v));
+    }
+}
@@ -11,6 +11,7 @@
 #include "box.hpp"
 #include "scaling_transformation.hpp"
 #include "point.hpp"
+#include "shape_evaluation.hpp"
 #include "vector.hpp"
 
 namespace geo
@@ -51,6 +52,11 @@ namespace geo
          */
         using scaling_type = scaling_transformation<K>;
 
+        /**
+         * Type of fused evaluation result.
+         */
+        using evaluation_type = shape_evaluation<K>;
+
         /**
          * Dimension of the underlying Euclidean space.
          */
@@ -127,6 +133,36 @@ namespace geo
         constexpr
         scaling_type skin_map(point_type const& p) const noexcept;
 
+        /**
+         * Evaluates potential, gradient, oriented distance and skin map at
+         * once, sharing the displacement from the center and its image by
+         * the quadratic form.
+         */
+        evaluation_type evaluate(point_type const& p) const noexcept;
+
+        // Exact query ---------------------------------------------------------
+
+        /**
+         * Returns the shortest distance from point to the surface, oriented
+         * like oriented_distance().
+         *
+         * Unlike oriented_distance(), the result is exact up to rounding at
+         * any distance. The closest point is found by solving the secular
+         * equation of the problem with a safeguarded Newton iteration, which
+         * costs several divisions per iteration and typically takes three to
+         * six iterations.
+         */
+        metric_type exact_oriented_distance(point_type const& p) const noexcept;
+
+        /**
+         * Returns the point of the surface closest to given point.
+         *
+         * Points inside the ellipsoid on the plane spanned by the longer
+         * semiaxes may have two closest points, in which case the one on the
+         * positive side of the shortest semiaxis is returned.
+         */
+        point_type closest_point(point_type const& p) const noexcept;
+
       private:
         point_type center_ {};
         scaling_type scaling_ {};
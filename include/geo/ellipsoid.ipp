@@ -1,11 +1,224 @@
 // Distributed under the Boost Software License, Version 1.0. (See accompanying
 // file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
 #include "box.hpp"
 #include "ellipsoid.hpp"
 
 namespace geo
 {
+    namespace detail
+    {
+        // The point x of the surface closest to p is found in the frame of
+        // the semiaxes a, with y[d] = |p[d] - center[d]| so that every
+        // coordinate is non-negative. Then x[d] = a[d]^2 y[d] / (s + g[d])
+        // where g[d] = a[d]^2 - b^2 for the shortest semiaxis b, and s is the
+        // root of the secular equation
+        //
+        //     F(s) = sum_d (u[d] / (s + g[d]))^2 = 1,   u[d] = a[d] y[d].
+        //
+        // Shifting the usual Lagrange multiplier by b^2 moves the pole of the
+        // shortest axis to s = 0, so the root is never negative and small
+        // roots keep full relative precision. The root is less than b^2 if
+        // and only if the point is inside.
+        //
+        // Newton steps are taken on psi(s) = 1 / sqrt(F(s)) - 1, which is
+        // increasing, concave and close to linear for s > 0. A Newton step
+        // from any point thus gives a lower bound of the root, and the chord
+        // between two points gives an upper bound. Near the pole, where psi
+        // bends sharply and Newton steps from below creep, the equation is
+        // solved for the pole terms with the others frozen, which gives a
+        // bound on the other side.
+        template<typename K>
+        struct ellipsoid_frame
+        {
+            using metric_type = typename K::metric;
+
+            static constexpr unsigned dimension = K::dimension;
+
+            // Number of plain Newton steps tried by root() before it falls
+            // back to bracketing the root.
+            static constexpr unsigned newton_iterations = 8;
+
+            // Upper bound on the number of bracketing iterations of root(),
+            // which stops as soon as the bracket stops shrinking.
+            static constexpr unsigned max_iterations = 64;
+
+            struct secular_value
+            {
+                metric_type psi;
+                metric_type newton;
+                metric_type pole_bound;
+            };
+
+            metric_type semiaxes[dimension];
+            metric_type gaps[dimension];
+            metric_type min_squared_semiaxis;
+            unsigned min_axis = 0;
+
+            // Freezing the other terms is only accurate when they sum to
+            // noticeably less than one.
+            metric_type pole_margin =
+                std::cbrt(std::numeric_limits<metric_type>::epsilon());
+
+            // A Newton step shorter than this fraction of the root leaves an
+            // error of the order of its square, which is below rounding.
+            metric_type step_tolerance =
+                std::sqrt(std::numeric_limits<metric_type>::epsilon());
+
+            explicit
+            ellipsoid_frame(ellipsoid<K> const& e) noexcept
+            {
+                auto const scaling = e.semiaxes();
+                for (unsigned d = 0; d < dimension; ++d) {
+                    semiaxes[d] = metric_type(scaling[d]);
+                    if (semiaxes[d] < semiaxes[min_axis]) {
+                        min_axis = d;
+                    }
+                }
+                // Factored so that gaps of equal semiaxes are exactly zero,
+                // even where the difference of squares would be fused.
+                metric_type const b = semiaxes[min_axis];
+                min_squared_semiaxis = b * b;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    gaps[d] = (semiaxes[d] - b) * (semiaxes[d] + b);
+                }
+            }
+
+            // Evaluates psi at s and the bounds derived from it. The
+            // Newton bound is s if psi has no slope, and the pole bound is
+            // negative if it is not usable.
+            secular_value evaluate(metric_type const* u, metric_type s) const noexcept
+            {
+                metric_type sum = 0;
+                metric_type slope = 0;
+                metric_type pole = 0;
+                metric_type others = 0;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    metric_type const den = s + gaps[d];
+                    metric_type const inv = den > 0 ? metric_type(1) / den : metric_type(0);
+                    metric_type const w = u[d] * inv;
+                    sum += w * w;
+                    slope += w * w * inv;
+                    if (gaps[d] > 0) {
+                        others += w * w;
+                    } else {
+                        pole += u[d] * u[d];
+                    }
+                }
+
+                metric_type const root = K::sqrt(sum);
+                secular_value value;
+                value.psi = sum > 0 ? metric_type(1) / root - 1 : metric_type(1);
+                value.newton = slope > 0 ? s + (root - 1) * sum / slope : s;
+                value.pole_bound = 1 - others >= pole_margin ?
+                    K::sqrt(pole / (1 - others)) : metric_type(-1);
+                return value;
+            }
+
+            // Returns the largest s known not to exceed the root: every term
+            // alone reaches one there.
+            metric_type lower_bound(metric_type const* u) const noexcept
+            {
+                metric_type lo = 0;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    lo = std::max(lo, u[d] - gaps[d]);
+                }
+                return lo;
+            }
+
+            // Returns the root of the secular equation for given distances
+            // y from the center along the axes. Returns zero for points on
+            // the medial plane of the shortest axis, where the root is at or
+            // below the pole.
+            metric_type root(metric_type const* y) const noexcept
+            {
+                metric_type u[dimension];
+                metric_type squared_norm = 0;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    u[d] = semiaxes[d] * y[d];
+                    squared_norm += u[d] * u[d];
+                }
+
+                // Newton steps from below settle most points in a few
+                // steps. The ones still creeping towards the root, close to
+                // the medial plane, go on with a shrinking bracket.
+                metric_type lo = lower_bound(u);
+                for (unsigned i = 0; i < newton_iterations; ++i) {
+                    metric_type const next = evaluate(u, lo).newton;
+                    if (next <= lo) {
+                        return lo;
+                    }
+                    metric_type const step = next - lo;
+                    lo = next;
+                    if (step <= step_tolerance * lo) {
+                        return lo;
+                    }
+                }
+
+                metric_type hi = std::max(lo, K::sqrt(squared_norm));
+                for (unsigned i = 0; i < max_iterations && lo < hi; ++i) {
+                    secular_value const low = evaluate(u, lo);
+                    secular_value const high = evaluate(u, hi);
+
+                    metric_type next_lo = std::max(lo, std::max(low.newton, high.newton));
+                    if (high.pole_bound >= 0 && high.pole_bound < hi) {
+                        next_lo = std::max(next_lo, high.pole_bound);
+                    }
+
+                    metric_type next_hi = hi;
+                    if (high.psi > low.psi) {
+                        next_hi = lo - low.psi * (hi - lo) / (high.psi - low.psi);
+                    }
+                    if (low.pole_bound >= 0) {
+                        next_hi = std::min(next_hi, low.pole_bound);
+                    }
+                    next_hi = std::min(hi, std::max(next_hi, next_lo));
+
+                    if (next_lo <= lo && next_hi >= hi) {
+                        break;
+                    }
+                    lo = next_lo;
+                    hi = next_hi;
+                }
+                return lo;
+            }
+
+            // Computes the closest point x in the frame from the root s.
+            void foot(metric_type const* y, metric_type s, metric_type* x) const noexcept
+            {
+                metric_type sum = 0;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    metric_type const den = s + gaps[d];
+                    x[d] = den > 0 ? semiaxes[d] * semiaxes[d] * y[d] / den : metric_type(0);
+                    sum += (x[d] / semiaxes[d]) * (x[d] / semiaxes[d]);
+                }
+
+                // On the medial plane, the foot leaves the plane along the
+                // shortest axis to reach the surface.
+                if (s <= 0) {
+                    metric_type const b = semiaxes[min_axis];
+                    x[min_axis] = b * K::sqrt(std::max(metric_type(1) - sum, metric_type(0)));
+                }
+            }
+
+            // Returns the oriented distance between y and its foot x.
+            metric_type oriented_distance(metric_type const* y, metric_type s,
+                                          metric_type const* x) const noexcept
+            {
+                metric_type sum = 0;
+                for (unsigned d = 0; d < dimension; ++d) {
+                    sum += (y[d] - x[d]) * (y[d] - x[d]);
+                }
+                metric_type const distance = K::sqrt(sum);
+                return s < min_squared_semiaxis ? -distance : distance;
+            }
+        };
+    }
+
     // Creation ------------------------------------------------------------
 
     template<typename K>
@@ -13,7 +226,7 @@ namespace geo
     ellipsoid<K>::ellipsoid(point_type const& center, scaling_type const& semiaxes)
         : center_ {center}
         , scaling_ {semiaxes}
-        , quadratic_map_ {scaling_type(scalar_type(1)) / semiaxes}
+        , quadratic_map_ {scaling_type(scalar_type(1)) / (semiaxes * semiaxes)}
     {
     }
 
@@ -51,11 +264,16 @@ namespace geo
         return scalar_type(2) * quadratic_map_(p - center());
     }
 
+    // The gradient is 2s where s is the image of r = p - center() by the
+    // quadratic form, so the queries below share r and s.
+
     template<typename K>
     constexpr
     auto ellipsoid<K>::oriented_distance(point_type const& p) const noexcept -> metric_type
     {
-        return potential(p) / norm(gradient(p));
+        vector_type const r = p - center();
+        vector_type const s = quadratic_map_(r);
+        return (inner_product(r, s) - metric_type(1)) / (metric_type(2) * norm(s));
     }
 
     template<typename K>
@@ -63,7 +281,68 @@ namespace geo
     auto ellipsoid<K>::skin_map(point_type const& p) const noexcept -> scaling_type
     {
         // Formula derived via linear approximation.
-        return (scalar_type(2) * potential(p) / squared_norm(gradient(p))) * quadratic_map_;
+        vector_type const r = p - center();
+        vector_type const s = quadratic_map_(r);
+        auto const pot = inner_product(r, s) - metric_type(1);
+        return static_cast<scalar_type>(pot / (metric_type(2) * squared_norm(s))) * quadratic_map_;
+    }
+
+    template<typename K>
+    auto ellipsoid<K>::evaluate(point_type const& p) const noexcept -> evaluation_type
+    {
+        vector_type const r = p - center();
+        vector_type const s = quadratic_map_(r);
+        metric_type const pot = inner_product(r, s) - metric_type(1);
+        metric_type const squared_half_grad = squared_norm(s);
+
+        evaluation_type result;
+        result.potential = pot;
+        result.gradient = scalar_type(2) * s;
+        result.oriented_distance = pot / (metric_type(2) * K::sqrt(squared_half_grad));
+        result.skin_map =
+            static_cast<scalar_type>(pot / (metric_type(2) * squared_half_grad)) * quadratic_map_;
+        return result;
+    }
+
+    // Exact query -------------------------------------------------------------
+
+    template<typename K>
+    auto ellipsoid<K>::exact_oriented_distance(point_type const& p) const noexcept
+    -> metric_type
+    {
+        detail::ellipsoid_frame<K> const frame {*this};
+        metric_type y[dimension];
+        for (unsigned d = 0; d < dimension; ++d) {
+            metric_type const r = metric_type(p[d]) - metric_type(center_[d]);
+            y[d] = r < 0 ? -r : r;
+        }
+
+        metric_type x[dimension];
+        metric_type const s = frame.root(y);
+        frame.foot(y, s, x);
+        return frame.oriented_distance(y, s, x);
+    }
+
+    template<typename K>
+    auto ellipsoid<K>::closest_point(point_type const& p) const noexcept -> point_type
+    {
+        detail::ellipsoid_frame<K> const frame {*this};
+        metric_type r[dimension];
+        metric_type y[dimension];
+        for (unsigned d = 0; d < dimension; ++d) {
+            r[d] = metric_type(p[d]) - metric_type(center_[d]);
+            y[d] = r[d] < 0 ? -r[d] : r[d];
+        }
+
+        metric_type x[dimension];
+        frame.foot(y, frame.root(y), x);
+
+        point_type result;
+        for (unsigned d = 0; d < dimension; ++d) {
+            metric_type const offset = r[d] < 0 ? -x[d] : x[d];
+            result[d] = static_cast<scalar_type>(metric_type(center_[d]) + offset);
+        }
+        return result;
     }
 
     // Basic algorithms --------------------------------------------------------
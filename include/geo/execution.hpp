@@ -0,0 +1,121 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Execution policies for parallel algorithms.
+//
+
+#ifndef GEO_EXECUTION_HPP
+#define GEO_EXECUTION_HPP
+
+#include <cstddef>
+#include <type_traits>
+
+namespace geo
+{
+    namespace execution
+    {
+        /**
+         * Policy requesting that an algorithm runs on the calling thread.
+         */
+        struct sequenced_policy
+        {
+        };
+
+        /**
+         * Policy allowing an algorithm to split work across threads.
+         */
+        struct parallel_policy
+        {
+        };
+
+        /**
+         * Policy allowing an algorithm to split work across threads and to
+         * vectorize work within each thread.
+         */
+        struct parallel_unsequenced_policy
+        {
+        };
+
+        /**
+         * Instance of sequenced_policy.
+         */
+        constexpr sequenced_policy seq {};
+
+        /**
+         * Instance of parallel_policy.
+         */
+        constexpr parallel_policy par {};
+
+        /**
+         * Instance of parallel_unsequenced_policy.
+         */
+        constexpr parallel_unsequenced_policy par_unseq {};
+    }
+
+    /**
+     * Trait telling whether T is one of the execution policy types.
+     */
+    template<typename T>
+    struct is_execution_policy : std::false_type
+    {
+    };
+
+    template<>
+    struct is_execution_policy<execution::sequenced_policy> : std::true_type
+    {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_policy> : std::true_type
+    {
+    };
+
+    template<>
+    struct is_execution_policy<execution::parallel_unsequenced_policy> : std::true_type
+    {
+    };
+
+    namespace detail
+    {
+        /*
+         * Enabled if Policy, with cv-ref qualifiers removed, is an execution
+         * policy.
+         */
+        template<typename Policy, typename T>
+        using enable_if_execution_policy = typename std::enable_if<
+            is_execution_policy<typename std::decay<Policy>::type>::value, T
+        >::type;
+
+        /*
+         * Returns the number of threads to use under given policy for count
+         * work items where each thread should get at least grain items.
+         */
+        inline
+        unsigned thread_count(execution::sequenced_policy,
+                              std::size_t count, std::size_t grain) noexcept;
+
+        inline
+        unsigned thread_count(execution::parallel_policy,
+                              std::size_t count, std::size_t grain) noexcept;
+
+        inline
+        unsigned thread_count(execution::parallel_unsequenced_policy,
+                              std::size_t count, std::size_t grain) noexcept;
+
+        /*
+         * Splits [0, count) into threads contiguous chunks and calls
+         * fn(chunk, begin, end) for each chunk. Chunk zero runs on the
+         * calling thread and the others on new threads. Returns after all
+         * chunks are done. If fn throws, the other chunks still run to
+         * completion and the exception of the lowest such chunk is rethrown
+         * on the calling thread.
+         */
+        template<typename Fn>
+        void parallel_chunks(unsigned threads, std::size_t count, Fn fn);
+    }
+}
+
+#include "execution.ipp"
+
+#endif
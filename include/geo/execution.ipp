@@ -0,0 +1,94 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <exception>
+#include <thread>
+#include <vector>
+
+#include "assert.hpp"
+#include "execution.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        inline
+        unsigned thread_count(execution::sequenced_policy,
+                              std::size_t, std::size_t) noexcept
+        {
+            return 1;
+        }
+
+        inline
+        unsigned thread_count(execution::parallel_policy,
+                              std::size_t count, std::size_t grain) noexcept
+        {
+            // hardware_concurrency() may return zero if unknown.
+            std::size_t const hardware = std::max(std::thread::hardware_concurrency(), 1u);
+            std::size_t const useful = std::max(count / std::max(grain, std::size_t(1)),
+                                                std::size_t(1));
+            return static_cast<unsigned>(std::min(hardware, useful));
+        }
+
+        inline
+        unsigned thread_count(execution::parallel_unsequenced_policy,
+                              std::size_t count, std::size_t grain) noexcept
+        {
+            return thread_count(execution::par, count, grain);
+        }
+
+        template<typename Fn>
+        void parallel_chunks(unsigned threads, std::size_t count, Fn fn)
+        {
+            GEO_ASSERT(threads > 0);
+
+            auto const chunk_begin = [=](unsigned chunk) {
+                return count / threads * chunk + std::min<std::size_t>(chunk, count % threads);
+            };
+
+            // An exception escaping a thread calls std::terminate, so each
+            // chunk stores its exception to be rethrown after the join.
+            std::vector<std::exception_ptr> errors(threads);
+            auto const run_chunk = [&errors](Fn& chunk_fn, unsigned chunk,
+                                             std::size_t begin, std::size_t end) {
+                try {
+                    chunk_fn(chunk, begin, end);
+                } catch (...) {
+                    errors[chunk] = std::current_exception();
+                }
+            };
+
+            // Joinable threads must not be destroyed, so join the workers
+            // started so far even if starting another one throws.
+            std::vector<std::thread> workers;
+            try {
+                workers.reserve(threads - 1);
+                for (unsigned chunk = 1; chunk < threads; ++chunk) {
+                    std::size_t const begin = chunk_begin(chunk);
+                    std::size_t const end = chunk_begin(chunk + 1);
+                    workers.emplace_back([=]() mutable {
+                        run_chunk(fn, chunk, begin, end);
+                    });
+                }
+            } catch (...) {
+                for (std::thread& worker : workers) {
+                    worker.join();
+                }
+                throw;
+            }
+
+            run_chunk(fn, 0, chunk_begin(0), chunk_begin(1));
+            for (std::thread& worker : workers) {
+                worker.join();
+            }
+
+            for (std::exception_ptr const& error : errors) {
+                if (error) {
+                    std::rethrow_exception(error);
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,98 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Kernel with integer coordinates and exact squared lengths.
+//
+// This header has no inline implementation file (*.ipp).
+//
+
+#ifndef GEO_INTEGER_KERNEL_HPP
+#define GEO_INTEGER_KERNEL_HPP
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+
+#include "standard_kernel.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Returns the largest b not exceeding bits such that the sum of n
+        // squares of integers less than 2^b in magnitude fits std::int64_t.
+        inline constexpr
+        unsigned exact_coordinate_bits(unsigned n, unsigned bits) noexcept
+        {
+            return ((std::uint64_t(1) << bits) - 1) * ((std::uint64_t(1) << bits) - 1)
+                       <= std::uint64_t(std::numeric_limits<std::int64_t>::max()) / n
+                ? bits : exact_coordinate_bits(n, bits - 1);
+        }
+    }
+
+    /**
+     * Kernel that uses signed integer coordinates of builtin type T and
+     * measures squared lengths exactly in std::int64_t.
+     *
+     * Inner products and squared distances are exact, and hence
+     * reproducible across machines, as long as the differences of
+     * coordinates along every axis are less than 2^coordinate_bits in
+     * magnitude. Lengths are computed by sqrt() in double, which is
+     * correctly rounded on IEEE 754 platforms.
+     *
+     * Use quantizer to map floating point coordinates in a known domain to
+     * this kernel and back.
+     */
+    template<typename T, unsigned n, typename Storage = packed_storage>
+    struct integer_kernel
+    {
+        static_assert(std::is_integral<T>::value && std::is_signed<T>::value, "");
+        static_assert(sizeof(T) <= 4, "");
+        static_assert(n >= 1, "");
+        static_assert(std::is_same<Storage, packed_storage>::value ||
+                      std::is_same<Storage, padded_storage>::value, "");
+
+        /**
+         * Aliased to T.
+         */
+        using scalar = T;
+
+        /**
+         * Aliased to std::int64_t.
+         */
+        using metric = std::int64_t;
+
+        /**
+         * Set to n.
+         */
+        static constexpr unsigned dimension = n;
+
+        /**
+         * Number of scalars stored for a coordinate tuple. Set to n for
+         * packed_storage and to n rounded up to a power of two for
+         * padded_storage.
+         */
+        static constexpr unsigned storage_dimension =
+            std::is_same<Storage, padded_storage>::value
+                ? detail::next_power_of_two(n) : n;
+
+        /**
+         * Number of bits of coordinate differences for which squared
+         * distances of n-dimensional points do not overflow metric.
+         */
+        static constexpr unsigned coordinate_bits =
+            detail::exact_coordinate_bits(n, std::numeric_limits<T>::digits);
+
+        /**
+         * Returns the square root of x in double.
+         */
+        static double sqrt(metric x) noexcept
+        {
+            return std::sqrt(static_cast<double>(x));
+        }
+    };
+}
+
+#endif
@@ -0,0 +1,64 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Allocator returning over-aligned storage.
+//
+
+#ifndef GEO_INTERNAL_ALIGNED_ALLOCATOR_HPP
+#define GEO_INTERNAL_ALIGNED_ALLOCATOR_HPP
+
+#include <cstddef>
+
+namespace geo
+{
+    /*
+     * Alignment suitable for the widest SIMD register we care about (64 bytes
+     * for AVX-512). This is also the common cache line size.
+     */
+    constexpr std::size_t simd_alignment = 64;
+
+    /*
+     * Standard allocator that aligns every allocation to Alignment bytes.
+     *
+     * C++14 operator new does not honor over-alignment, so this allocator
+     * over-allocates and stores the original pointer just before the aligned
+     * block.
+     */
+    template<typename T, std::size_t Alignment = simd_alignment>
+    struct aligned_allocator
+    {
+        static_assert(Alignment >= alignof(T), "");
+        static_assert(Alignment >= alignof(void*), "");
+        static_assert((Alignment & (Alignment - 1)) == 0, "");
+
+        using value_type = T;
+
+        template<typename U>
+        struct rebind
+        {
+            using other = aligned_allocator<U, Alignment>;
+        };
+
+        aligned_allocator() noexcept = default;
+
+        template<typename U>
+        aligned_allocator(aligned_allocator<U, Alignment> const&) noexcept;
+
+        T* allocate(std::size_t n);
+
+        void deallocate(T* ptr, std::size_t n) noexcept;
+    };
+
+    template<typename T, typename U, std::size_t Alignment>
+    bool operator==(aligned_allocator<T, Alignment> const&,
+                    aligned_allocator<U, Alignment> const&) noexcept;
+
+    template<typename T, typename U, std::size_t Alignment>
+    bool operator!=(aligned_allocator<T, Alignment> const&,
+                    aligned_allocator<U, Alignment> const&) noexcept;
+}
+
+#include "aligned_allocator.ipp"
+
+#endif
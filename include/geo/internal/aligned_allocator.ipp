@@ -0,0 +1,58 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <new>
+
+#include "aligned_allocator.hpp"
+
+namespace geo
+{
+    template<typename T, std::size_t Alignment>
+    template<typename U>
+    aligned_allocator<T, Alignment>::aligned_allocator(
+        aligned_allocator<U, Alignment> const&) noexcept
+    {
+    }
+
+    template<typename T, std::size_t Alignment>
+    T* aligned_allocator<T, Alignment>::allocate(std::size_t n)
+    {
+        if (n > (std::numeric_limits<std::size_t>::max() - Alignment) / sizeof(T)) {
+            throw std::bad_alloc();
+        }
+
+        // The header slot holding the original pointer always fits in the
+        // slack because Alignment >= sizeof(void*).
+        void* const raw = ::operator new(n * sizeof(T) + Alignment);
+        auto const addr = reinterpret_cast<std::uintptr_t>(raw);
+        auto const aligned = (addr + Alignment) & ~std::uintptr_t(Alignment - 1);
+        reinterpret_cast<void**>(aligned)[-1] = raw;
+
+        return reinterpret_cast<T*>(aligned);
+    }
+
+    template<typename T, std::size_t Alignment>
+    void aligned_allocator<T, Alignment>::deallocate(T* ptr, std::size_t) noexcept
+    {
+        if (ptr) {
+            ::operator delete(reinterpret_cast<void**>(ptr)[-1]);
+        }
+    }
+
+    template<typename T, typename U, std::size_t Alignment>
+    bool operator==(aligned_allocator<T, Alignment> const&,
+                    aligned_allocator<U, Alignment> const&) noexcept
+    {
+        return true;
+    }
+
+    template<typename T, typename U, std::size_t Alignment>
+    bool operator!=(aligned_allocator<T, Alignment> const&,
+                    aligned_allocator<U, Alignment> const&) noexcept
+    {
+        return false;
+    }
+}
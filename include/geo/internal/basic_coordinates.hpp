@@ -10,12 +10,55 @@
 #ifndef GEO_INTERNAL_BASIC_COORDINATES_HPP
 #define GEO_INTERNAL_BASIC_COORDINATES_HPP
 
+#include <limits>
 #include <type_traits>
+#include <utility>
 
 #include "coordinates_storage.hpp"
 
 namespace geo
 {
+    namespace detail
+    {
+        /*
+         * Number of scalars stored for a coordinate tuple of kernel K. This is
+         * K::storage_dimension if K defines it, otherwise K::dimension.
+         */
+        template<typename K, typename = void>
+        struct storage_dimension_of
+        {
+            static constexpr unsigned value = K::dimension;
+        };
+
+        template<typename K>
+        struct storage_dimension_of<K, decltype(void(K::storage_dimension))>
+        {
+            static constexpr unsigned value = K::storage_dimension;
+        };
+
+        /*
+         * Type of lengths measured in kernel K, that is, the type returned by
+         * K::sqrt(). This is K::metric for floating point kernels, but may
+         * be a floating point type for kernels measuring squared lengths
+         * exactly in integers.
+         */
+        template<typename K>
+        using length_type_of =
+            decltype(K::sqrt(std::declval<typename K::metric>()));
+
+        /*
+         * Returns a value not less than any value of T: infinity if T has
+         * one, otherwise the maximum value.
+         */
+        template<typename T>
+        constexpr T unbounded_value() noexcept
+        {
+            return std::numeric_limits<T>::has_infinity
+                ? std::numeric_limits<T>::infinity()
+                : std::numeric_limits<T>::max();
+        }
+    }
+
     /*
      * Implements basic features of coordinate tuple.
      *
@@ -29,11 +72,16 @@ namespace geo
      */
     template<typename Tag, typename K>
     struct basic_coordinates
-        : coordinates_storage<typename K::scalar, K::dimension>
+        : coordinates_storage<typename K::scalar,
+                              K::dimension,
+                              detail::storage_dimension_of<K>::value>
     {
         static constexpr unsigned dimension = K::dimension;
+        static constexpr unsigned storage_dimension =
+            detail::storage_dimension_of<K>::value;
         using scalar_type = typename K::scalar;
-        using base_type = coordinates_storage<scalar_type, dimension>;
+        using base_type =
+            coordinates_storage<scalar_type, dimension, storage_dimension>;
 
         constexpr
         basic_coordinates() noexcept = default;
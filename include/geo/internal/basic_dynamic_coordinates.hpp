@@ -0,0 +1,81 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Common base class for dynamic_point and dynamic_vector.
+//
+// This header has no inline implementation file (*.ipp).
+//
+
+#ifndef GEO_INTERNAL_BASIC_DYNAMIC_COORDINATES_HPP
+#define GEO_INTERNAL_BASIC_DYNAMIC_COORDINATES_HPP
+
+#include "../assert.hpp"
+
+namespace geo
+{
+    /*
+     * Read-only view of a coordinate tuple whose dimension is known at run
+     * time. The Tag parameter discriminates points from vectors as in
+     * basic_coordinates.
+     *
+     * The viewed tuple has dimension() meaningful scalars followed by
+     * lanes() - dimension() padding scalars that are zero. Kernels may read
+     * the padding, which lets them run over whole registers.
+     */
+    template<typename Tag, typename K>
+    struct basic_dynamic_coordinates
+    {
+        using scalar_type = typename K::scalar;
+        using const_iterator = scalar_type const*;
+
+        constexpr
+        basic_dynamic_coordinates() noexcept = default;
+
+        /*
+         * Views dimension scalars at data, without padding.
+         */
+        constexpr
+        basic_dynamic_coordinates(scalar_type const* data, unsigned dimension) noexcept
+            : data_ {data}
+            , dimension_ {dimension}
+            , lanes_ {dimension}
+        {
+        }
+
+        /*
+         * Views dimension scalars at data followed by zero padding up to
+         * lanes scalars.
+         */
+        constexpr
+        basic_dynamic_coordinates(scalar_type const* data, unsigned dimension,
+                                  unsigned lanes) noexcept
+            : data_ {data}
+            , dimension_ {dimension}
+            , lanes_ {lanes}
+        {
+            GEO_ASSERT(lanes >= dimension);
+        }
+
+        constexpr unsigned dimension() const noexcept { return dimension_; }
+        constexpr unsigned lanes() const noexcept { return lanes_; }
+        constexpr scalar_type const* data() const noexcept { return data_; }
+
+        constexpr const_iterator begin() const noexcept { return data_; }
+        constexpr const_iterator end() const noexcept { return data_ + dimension_; }
+
+        constexpr
+        scalar_type const& operator[](unsigned index) const
+        {
+            GEO_ASSERT(index < dimension_);
+            return data_[index];
+        }
+
+      private:
+        scalar_type const* data_ = nullptr;
+        unsigned dimension_ = 0;
+        unsigned lanes_ = 0;
+    };
+}
+
+#endif
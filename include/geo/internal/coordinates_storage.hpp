@@ -17,19 +17,25 @@ namespace geo
     struct storage_alignment;
 
     /*
-     * Sequence of N values of type T.
+     * Sequence of N values of type T, optionally followed by P - N padding
+     * values that are kept zero.
      *
-     * The size of this class is exactly sizeof(T[N]) without padding and the
-     * class is trivially copiable if T is a built-in type.
+     * The size of this class is exactly sizeof(T[P]) and the class is
+     * trivially copiable if T is a built-in type. Range access, indexing,
+     * comparison and input/output see only the first N values. The padding
+     * is visible only through data().
      */
-    template<typename T, unsigned N>
-    struct alignas(storage_alignment<T, N>::value) coordinates_storage
+    template<typename T, unsigned N, unsigned P = N>
+    struct alignas(storage_alignment<T, P>::value) coordinates_storage
     {
+        static_assert(P >= N, "");
+
         using scalar_type = T;
         using iterator = T*;
         using const_iterator = T const*;
 
         static constexpr unsigned dimension = N;
+        static constexpr unsigned storage_dimension = P;
         static constexpr char delimiter = ' ';
 
         /*
@@ -64,37 +70,45 @@ namespace geo
         constexpr
         scalar_type const& operator[](unsigned index) const;
 
+        /*
+         * Access to all storage_dimension values including padding.
+         */
+        constexpr scalar_type* data() noexcept;
+        constexpr scalar_type const* data() const noexcept;
+
       private:
-        scalar_type data_[dimension] {};
+        scalar_type data_[storage_dimension] {};
     };
 
     /*
      * Compares for coordinate-wise equality.
      */
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    bool operator==(coordinates_storage<T, N> const& x,
-                    coordinates_storage<T, N> const& y) noexcept;
+    bool operator==(coordinates_storage<T, N, P> const& x,
+                    coordinates_storage<T, N, P> const& y) noexcept;
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    bool operator!=(coordinates_storage<T, N> const& x,
-                    coordinates_storage<T, N> const& y) noexcept;
+    bool operator!=(coordinates_storage<T, N, P> const& x,
+                    coordinates_storage<T, N, P> const& y) noexcept;
 
     /*
      * Input from stream. Expects space-delimited coordinate values.
      */
-    template<typename Char, typename CharTraits, typename T, unsigned N>
+    template<typename Char, typename CharTraits,
+             typename T, unsigned N, unsigned P>
     auto operator>>(std::basic_istream<Char, CharTraits>& in,
-                    coordinates_storage<T, N>& coords)
+                    coordinates_storage<T, N, P>& coords)
     -> std::basic_istream<Char, CharTraits>&;
 
     /*
      * Output to stream. A space is used to delimit coordinate values.
      */
-    template<typename Char, typename CharTraits, typename T, unsigned N>
+    template<typename Char, typename CharTraits,
+             typename T, unsigned N, unsigned P>
     auto operator<<(std::basic_ostream<Char, CharTraits>& out,
-                    coordinates_storage<T, N> const& coords)
+                    coordinates_storage<T, N, P> const& coords)
     -> std::basic_ostream<Char, CharTraits>&;
 }
 
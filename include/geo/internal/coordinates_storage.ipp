@@ -33,84 +33,98 @@ namespace geo
 
     // Creation ----------------------------------------------------------------
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    coordinates_storage<T, N>::coordinates_storage() noexcept = default;
+    coordinates_storage<T, N, P>::coordinates_storage() noexcept = default;
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     template<typename... Xs>
     constexpr
-    coordinates_storage<T, N>::coordinates_storage(Xs const&... coords) noexcept
+    coordinates_storage<T, N, P>::coordinates_storage(Xs const&... coords) noexcept
         : data_ {coords...}
     {
     }
 
     // Element access ----------------------------------------------------------
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::begin() noexcept -> iterator
+    auto coordinates_storage<T, N, P>::begin() noexcept -> iterator
     {
         return std::begin(data_);
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::end() noexcept -> iterator
+    auto coordinates_storage<T, N, P>::end() noexcept -> iterator
     {
-        return std::end(data_);
+        return std::begin(data_) + dimension;
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::begin() const noexcept -> const_iterator
+    auto coordinates_storage<T, N, P>::begin() const noexcept -> const_iterator
     {
         return std::begin(data_);
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::end() const noexcept -> const_iterator
+    auto coordinates_storage<T, N, P>::end() const noexcept -> const_iterator
     {
-        return std::end(data_);
+        return std::begin(data_) + dimension;
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::cbegin() const noexcept -> const_iterator
+    auto coordinates_storage<T, N, P>::cbegin() const noexcept -> const_iterator
     {
         return std::begin(data_);
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    auto coordinates_storage<T, N>::cend() const noexcept -> const_iterator
+    auto coordinates_storage<T, N, P>::cend() const noexcept -> const_iterator
     {
-        return std::end(data_);
+        return std::begin(data_) + dimension;
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    T& coordinates_storage<T, N>::operator[](unsigned index)
+    T& coordinates_storage<T, N, P>::operator[](unsigned index)
     {
         GEO_EXTRA_ASSERT(index < dimension);
         return data_[index];
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    T const& coordinates_storage<T, N>::operator[](unsigned index) const
+    T const& coordinates_storage<T, N, P>::operator[](unsigned index) const
     {
         GEO_EXTRA_ASSERT(index < dimension);
         return data_[index];
     }
 
+    template<typename T, unsigned N, unsigned P>
+    constexpr
+    T* coordinates_storage<T, N, P>::data() noexcept
+    {
+        return data_;
+    }
+
+    template<typename T, unsigned N, unsigned P>
+    constexpr
+    T const* coordinates_storage<T, N, P>::data() const noexcept
+    {
+        return data_;
+    }
+
     // Regular operators -------------------------------------------------------
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    bool operator==(coordinates_storage<T, N> const& x,
-                    coordinates_storage<T, N> const& y) noexcept
+    bool operator==(coordinates_storage<T, N, P> const& x,
+                    coordinates_storage<T, N, P> const& y) noexcept
     {
         for (unsigned i = 0; i < N; ++i) {
             if (x[i] != y[i]) {
@@ -120,10 +134,10 @@ namespace geo
         return true;
     }
 
-    template<typename T, unsigned N>
+    template<typename T, unsigned N, unsigned P>
     constexpr
-    bool operator!=(coordinates_storage<T, N> const& x,
-                    coordinates_storage<T, N> const& y) noexcept
+    bool operator!=(coordinates_storage<T, N, P> const& x,
+                    coordinates_storage<T, N, P> const& y) noexcept
     {
         return !(x == y);
     }
@@ -131,9 +145,9 @@ namespace geo
     // Input/output ------------------------------------------------------------
 
     template<typename Char, typename CharTraits,
-             typename T, unsigned N>
+             typename T, unsigned N, unsigned P>
     auto operator>>(std::basic_istream<Char, CharTraits>& in,
-                    coordinates_storage<T, N>& coords)
+                    coordinates_storage<T, N, P>& coords)
     -> std::basic_istream<Char, CharTraits>&
     {
         using stream_type = std::basic_istream<Char, CharTraits>;
@@ -148,9 +162,9 @@ namespace geo
     }
 
     template<typename Char, typename CharTraits,
-             typename T, unsigned N>
+             typename T, unsigned N, unsigned P>
     auto operator<<(std::basic_ostream<Char, CharTraits>& out,
-               coordinates_storage<T, N> const& coords)
+               coordinates_storage<T, N, P> const& coords)
     -> std::basic_ostream<Char, CharTraits>&
     {
         using stream_type = std::basic_ostream<Char, CharTraits>;
@@ -0,0 +1,365 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Expression templates for the operators of linear_operations and
+// multiplicative_operations.
+//
+// Defining GEO_EXPRESSION_TEMPLATES makes the arithmetic operators of vector
+// and scaling_transformation return lightweight expression objects instead
+// of coordinate tuples. A whole expression such as a + b * k - c is then
+// evaluated in one loop over the coordinates when it is converted to the
+// tuple type, with no temporary tuple per operator. Every lane undergoes the
+// same operations in the same order as without the macro, so results are the
+// same unless the compiler contracts a product and a sum of the expression
+// into a fused multiply-add, which it can do once they share a loop.
+//
+// Expressions hold operands that are named tuples by reference and copy
+// temporary tuples, so an expression stored in an auto variable stays valid
+// as long as the named operands do. Functions that deduce the kernel from a
+// tuple type, like inner_product(), need the expression to be converted first
+// with eval() or by naming the tuple type.
+//
+
+#ifndef GEO_INTERNAL_LINEAR_EXPRESSIONS_HPP
+#define GEO_INTERNAL_LINEAR_EXPRESSIONS_HPP
+
+#include <type_traits>
+
+#include "basic_coordinates.hpp"
+
+namespace geo
+{
+    template<typename D, typename K>
+    struct linear_operations;
+
+    template<typename D, typename K>
+    struct multiplicative_operations;
+
+    /**
+     * CRTP base of the expressions evaluating to D.
+     *
+     * E provides lane(i), the value of the i-th storage lane of the result,
+     * and padding_safe, which tells whether lane() keeps zero padding zero.
+     * Unsafe expressions, those involving divisions, are evaluated over the
+     * meaningful lanes only.
+     */
+    template<typename E, typename D, typename K>
+    struct linear_expression
+    {
+        using derived_type = D;
+        using expression_type = E;
+        using scalar_type = typename K::scalar;
+        static constexpr unsigned dimension = K::dimension;
+        static constexpr unsigned storage_dimension =
+            detail::storage_dimension_of<K>::value;
+
+        /**
+         * Evaluates the expression.
+         */
+        constexpr
+        derived_type eval() const;
+
+        /**
+         * Same as eval().
+         */
+        constexpr
+        operator derived_type() const;
+
+        /**
+         * Evaluates a single coordinate.
+         */
+        constexpr
+        scalar_type operator[](unsigned index) const;
+
+        constexpr
+        expression_type const& expression() const noexcept;
+    };
+
+    namespace detail
+    {
+        /*
+         * Operand kind of T: tuples deriving from linear_operations<D, K>
+         * and expressions deriving from linear_expression<E, D, K>.
+         */
+        template<typename D, typename K, bool Terminal>
+        struct linear_signature
+        {
+            using derived_type = D;
+            using kernel = K;
+            using scalar_type = typename K::scalar;
+            static constexpr bool terminal = Terminal;
+        };
+
+        template<typename D, typename K>
+        linear_signature<D, K, true>
+        linear_signature_of(linear_operations<D, K> const*);
+
+        template<typename E, typename D, typename K>
+        linear_signature<D, K, false>
+        linear_signature_of(linear_expression<E, D, K> const*);
+
+        template<typename T, typename = void>
+        struct linear_operand_traits
+        {
+        };
+
+        template<typename T>
+        struct linear_operand_traits<
+            T, decltype(void(linear_signature_of(std::declval<T const*>())))
+        >
+            : decltype(linear_signature_of(std::declval<T const*>()))
+        {
+        };
+
+        template<typename A>
+        using linear_traits_t = linear_operand_traits<std::decay_t<A>>;
+
+        /*
+         * Type an expression stores operand A as: named tuples by const
+         * reference, temporary tuples and expressions by value.
+         */
+        template<typename A>
+        using linear_operand_t = std::conditional_t<
+            linear_traits_t<A>::terminal && std::is_lvalue_reference<A>::value,
+            std::decay_t<A> const&,
+            std::decay_t<A>
+        >;
+
+        /*
+         * Kernel of A and B if both are linear operands evaluating to the
+         * same tuple type. Substitution fails otherwise.
+         */
+        template<typename A, typename B>
+        using linear_pair_kernel_t = std::enable_if_t<
+            std::is_same<typename linear_traits_t<A>::derived_type,
+                         typename linear_traits_t<B>::derived_type>::value,
+            typename linear_traits_t<A>::kernel
+        >;
+
+        /*
+         * Same as linear_pair_kernel_t but also requires the tuple type to
+         * derive from multiplicative_operations.
+         */
+        template<typename A, typename B>
+        using multiplicative_pair_kernel_t = std::enable_if_t<
+            std::is_base_of<
+                multiplicative_operations<typename linear_traits_t<A>::derived_type,
+                                          linear_pair_kernel_t<A, B>>,
+                typename linear_traits_t<A>::derived_type
+            >::value,
+            linear_pair_kernel_t<A, B>
+        >;
+
+        /*
+         * Lane operations.
+         */
+        struct lane_plus
+        {
+            static constexpr bool padding_safe = true;
+
+            template<typename T>
+            static constexpr T apply(T a, T b) noexcept { return a + b; }
+        };
+
+        struct lane_minus
+        {
+            static constexpr bool padding_safe = true;
+
+            template<typename T>
+            static constexpr T apply(T a, T b) noexcept { return a - b; }
+        };
+
+        struct lane_multiplies
+        {
+            static constexpr bool padding_safe = true;
+
+            template<typename T>
+            static constexpr T apply(T a, T b) noexcept { return a * b; }
+        };
+
+        struct lane_divides
+        {
+            static constexpr bool padding_safe = false;
+
+            template<typename T>
+            static constexpr T apply(T a, T b) noexcept { return a / b; }
+        };
+
+        /*
+         * Value of the i-th storage lane of an operand.
+         */
+        template<typename D, typename K>
+        constexpr
+        typename K::scalar linear_lane(linear_operations<D, K> const& a,
+                                       unsigned i) noexcept;
+
+        template<typename E, typename D, typename K>
+        constexpr
+        typename K::scalar linear_lane(linear_expression<E, D, K> const& a,
+                                       unsigned i) noexcept;
+
+        /*
+         * Whether operand A keeps zero padding zero.
+         */
+        template<typename A, bool = linear_traits_t<A>::terminal>
+        struct operand_padding_safe : std::true_type
+        {
+        };
+
+        template<typename A>
+        struct operand_padding_safe<A, false>
+            : std::integral_constant<bool, std::decay_t<A>::padding_safe>
+        {
+        };
+
+        /*
+         * Negation of an operand.
+         */
+        template<typename D, typename K, typename A>
+        struct linear_negation
+            : linear_expression<linear_negation<D, K, A>, D, K>
+        {
+            static constexpr bool padding_safe = operand_padding_safe<A>::value;
+
+            template<typename T>
+            constexpr explicit
+            linear_negation(T&& a) noexcept;
+
+            constexpr
+            typename K::scalar lane(unsigned i) const noexcept;
+
+            A operand;
+        };
+
+        /*
+         * Lane-wise operation on two operands.
+         */
+        template<typename D, typename K, typename L, typename R, typename Op>
+        struct linear_binary
+            : linear_expression<linear_binary<D, K, L, R, Op>, D, K>
+        {
+            static constexpr bool padding_safe =
+                Op::padding_safe &&
+                operand_padding_safe<L>::value &&
+                operand_padding_safe<R>::value;
+
+            template<typename T, typename U>
+            constexpr
+            linear_binary(T&& a, U&& b) noexcept;
+
+            constexpr
+            typename K::scalar lane(unsigned i) const noexcept;
+
+            L left;
+            R right;
+        };
+
+        /*
+         * Lane-wise operation on an operand and a scalar. Padding lanes are
+         * zero whatever the scalar.
+         */
+        template<typename D, typename K, typename A, typename Op>
+        struct linear_scalar
+            : linear_expression<linear_scalar<D, K, A, Op>, D, K>
+        {
+            static constexpr bool padding_safe =
+                Op::padding_safe && operand_padding_safe<A>::value;
+
+            template<typename T>
+            constexpr
+            linear_scalar(T&& a, typename K::scalar k) noexcept;
+
+            constexpr
+            typename K::scalar lane(unsigned i) const noexcept;
+
+            A operand;
+            typename K::scalar factor;
+        };
+
+        template<typename A, typename B, typename Op>
+        using linear_binary_t = linear_binary<
+            typename linear_traits_t<A>::derived_type,
+            linear_pair_kernel_t<A, B>,
+            linear_operand_t<A>,
+            linear_operand_t<B>,
+            Op
+        >;
+
+        template<typename A, typename B, typename Op>
+        using multiplicative_binary_t = linear_binary<
+            typename linear_traits_t<A>::derived_type,
+            multiplicative_pair_kernel_t<A, B>,
+            linear_operand_t<A>,
+            linear_operand_t<B>,
+            Op
+        >;
+
+        template<typename A, typename Op>
+        using linear_scalar_t = linear_scalar<
+            typename linear_traits_t<A>::derived_type,
+            typename linear_traits_t<A>::kernel,
+            linear_operand_t<A>,
+            Op
+        >;
+
+        template<typename A>
+        using linear_negation_t = linear_negation<
+            typename linear_traits_t<A>::derived_type,
+            typename linear_traits_t<A>::kernel,
+            linear_operand_t<A>
+        >;
+
+        template<typename A>
+        using linear_scalar_type_t = typename linear_traits_t<A>::scalar_type;
+    }
+
+    // Operators ---------------------------------------------------------------
+
+    template<typename A>
+    constexpr
+    auto operator+(A&& a) noexcept -> detail::linear_operand_t<A>;
+
+    template<typename A>
+    constexpr
+    auto operator-(A&& a) noexcept -> detail::linear_negation_t<A>;
+
+    template<typename A, typename B>
+    constexpr
+    auto operator+(A&& a, B&& b) noexcept
+    -> detail::linear_binary_t<A, B, detail::lane_plus>;
+
+    template<typename A, typename B>
+    constexpr
+    auto operator-(A&& a, B&& b) noexcept
+    -> detail::linear_binary_t<A, B, detail::lane_minus>;
+
+    template<typename A>
+    constexpr
+    auto operator*(A&& a, detail::linear_scalar_type_t<A> k) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_multiplies>;
+
+    template<typename A>
+    constexpr
+    auto operator*(detail::linear_scalar_type_t<A> k, A&& a) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_multiplies>;
+
+    template<typename A>
+    constexpr
+    auto operator/(A&& a, detail::linear_scalar_type_t<A> k) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_divides>;
+
+    template<typename A, typename B>
+    constexpr
+    auto operator*(A&& a, B&& b) noexcept
+    -> detail::multiplicative_binary_t<A, B, detail::lane_multiplies>;
+
+    template<typename A, typename B>
+    constexpr
+    auto operator/(A&& a, B&& b) noexcept
+    -> detail::multiplicative_binary_t<A, B, detail::lane_divides>;
+}
+
+#include "linear_expressions.ipp"
+
+#endif
@@ -0,0 +1,198 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <type_traits>
+#include <utility>
+
+#include "../assert.hpp"
+#include "linear_expressions.hpp"
+
+namespace geo
+{
+    // Evaluation --------------------------------------------------------------
+
+    template<typename E, typename D, typename K>
+    constexpr
+    auto linear_expression<E, D, K>::expression() const noexcept -> expression_type const&
+    {
+        return static_cast<expression_type const&>(*this);
+    }
+
+    // Every lane is written, so the result needs no particular initial value.
+    // Expressions involving a division leave the padding lanes to zero.
+    template<typename E, typename D, typename K>
+    constexpr
+    auto linear_expression<E, D, K>::eval() const -> derived_type
+    {
+        constexpr unsigned lanes_count =
+            expression_type::padding_safe ? storage_dimension : dimension;
+
+        expression_type const& e = expression();
+        derived_type result;
+        scalar_type* const lanes = result.data();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] = e.lane(i);
+        }
+        for (unsigned i = lanes_count; i < storage_dimension; ++i) {
+            lanes[i] = scalar_type(0);
+        }
+        return result;
+    }
+
+    template<typename E, typename D, typename K>
+    constexpr
+    linear_expression<E, D, K>::operator derived_type() const
+    {
+        return eval();
+    }
+
+    template<typename E, typename D, typename K>
+    constexpr
+    auto linear_expression<E, D, K>::operator[](unsigned index) const -> scalar_type
+    {
+        GEO_ASSERT(index < dimension);
+        return expression().lane(index);
+    }
+
+    namespace detail
+    {
+        template<typename D, typename K>
+        constexpr
+        typename K::scalar linear_lane(linear_operations<D, K> const& a,
+                                       unsigned i) noexcept
+        {
+            return a.derived().data()[i];
+        }
+
+        template<typename E, typename D, typename K>
+        constexpr
+        typename K::scalar linear_lane(linear_expression<E, D, K> const& a,
+                                       unsigned i) noexcept
+        {
+            return a.expression().lane(i);
+        }
+
+        // Nodes ---------------------------------------------------------------
+
+        template<typename D, typename K, typename A>
+        template<typename T>
+        constexpr
+        linear_negation<D, K, A>::linear_negation(T&& a) noexcept
+            : operand(std::forward<T>(a))
+        {
+        }
+
+        template<typename D, typename K, typename A>
+        constexpr
+        typename K::scalar linear_negation<D, K, A>::lane(unsigned i) const noexcept
+        {
+            return -linear_lane(operand, i);
+        }
+
+        template<typename D, typename K, typename L, typename R, typename Op>
+        template<typename T, typename U>
+        constexpr
+        linear_binary<D, K, L, R, Op>::linear_binary(T&& a, U&& b) noexcept
+            : left(std::forward<T>(a))
+            , right(std::forward<U>(b))
+        {
+        }
+
+        template<typename D, typename K, typename L, typename R, typename Op>
+        constexpr
+        typename K::scalar linear_binary<D, K, L, R, Op>::lane(unsigned i) const noexcept
+        {
+            return Op::apply(linear_lane(left, i), linear_lane(right, i));
+        }
+
+        template<typename D, typename K, typename A, typename Op>
+        template<typename T>
+        constexpr
+        linear_scalar<D, K, A, Op>::linear_scalar(T&& a, typename K::scalar k) noexcept
+            : operand(std::forward<T>(a))
+            , factor(k)
+        {
+        }
+
+        template<typename D, typename K, typename A, typename Op>
+        constexpr
+        typename K::scalar linear_scalar<D, K, A, Op>::lane(unsigned i) const noexcept
+        {
+            // Zero padding times an infinite factor would be NaN.
+            return i < K::dimension ? Op::apply(linear_lane(operand, i), factor)
+                                    : typename K::scalar(0);
+        }
+    }
+
+    // Operators ---------------------------------------------------------------
+
+    template<typename A>
+    constexpr
+    auto operator+(A&& a) noexcept -> detail::linear_operand_t<A>
+    {
+        return std::forward<A>(a);
+    }
+
+    template<typename A>
+    constexpr
+    auto operator-(A&& a) noexcept -> detail::linear_negation_t<A>
+    {
+        return detail::linear_negation_t<A>(std::forward<A>(a));
+    }
+
+    template<typename A, typename B>
+    constexpr
+    auto operator+(A&& a, B&& b) noexcept
+    -> detail::linear_binary_t<A, B, detail::lane_plus>
+    {
+        return {std::forward<A>(a), std::forward<B>(b)};
+    }
+
+    template<typename A, typename B>
+    constexpr
+    auto operator-(A&& a, B&& b) noexcept
+    -> detail::linear_binary_t<A, B, detail::lane_minus>
+    {
+        return {std::forward<A>(a), std::forward<B>(b)};
+    }
+
+    template<typename A>
+    constexpr
+    auto operator*(A&& a, detail::linear_scalar_type_t<A> k) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_multiplies>
+    {
+        return {std::forward<A>(a), k};
+    }
+
+    template<typename A>
+    constexpr
+    auto operator*(detail::linear_scalar_type_t<A> k, A&& a) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_multiplies>
+    {
+        return {std::forward<A>(a), k};
+    }
+
+    template<typename A>
+    constexpr
+    auto operator/(A&& a, detail::linear_scalar_type_t<A> k) noexcept
+    -> detail::linear_scalar_t<A, detail::lane_divides>
+    {
+        return {std::forward<A>(a), k};
+    }
+
+    template<typename A, typename B>
+    constexpr
+    auto operator*(A&& a, B&& b) noexcept
+    -> detail::multiplicative_binary_t<A, B, detail::lane_multiplies>
+    {
+        return {std::forward<A>(a), std::forward<B>(b)};
+    }
+
+    template<typename A, typename B>
+    constexpr
+    auto operator/(A&& a, B&& b) noexcept
+    -> detail::multiplicative_binary_t<A, B, detail::lane_divides>
+    {
+        return {std::forward<A>(a), std::forward<B>(b)};
+    }
+}
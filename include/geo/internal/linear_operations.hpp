@@ -8,6 +8,12 @@
 #ifndef GEO_INTERNAL_LINEAR_OPERATIONS_HPP
 #define GEO_INTERNAL_LINEAR_OPERATIONS_HPP
 
+#include "basic_coordinates.hpp"
+
+#ifdef GEO_EXPRESSION_TEMPLATES
+# include "linear_expressions.hpp"
+#endif
+
 namespace geo
 {
     /**
@@ -15,14 +21,27 @@ namespace geo
      *
      * This class implements unary +, unary -, addition, subtraction,
      * multiplication by scalar and division by scalar on class D. The type
-     * of scalar is K::scalar.
+     * of scalar is K::scalar. Kernels may measure in a wider K::metric, so
+     * factors computed in metric_type are narrowed explicitly by callers.
+     *
+     * Operations that keep zero padding zero run over all storage lanes of
+     * D so that a padded tuple is processed as one vector operation.
+     * Division runs over the meaningful lanes only since 0 / 0 would
+     * poison the padding.
+     *
+     * If GEO_EXPRESSION_TEMPLATES is defined, the operators return
+     * expressions that are evaluated in one pass when converted to D. See
+     * linear_expressions.hpp.
      */
     template<typename D, typename K>
     struct linear_operations
     {
         using derived_type = D;
         using scalar_type = typename K::scalar;
+        using metric_type = typename K::metric;
         static constexpr unsigned dimension = K::dimension;
+        static constexpr unsigned storage_dimension =
+            detail::storage_dimension_of<K>::value;
 
         constexpr
         derived_type& operator+=(derived_type const& other) noexcept;
@@ -36,6 +55,16 @@ namespace geo
         constexpr
         derived_type& operator/=(scalar_type k);
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+        template<typename E>
+        constexpr
+        derived_type& operator+=(linear_expression<E, D, K> const& other) noexcept;
+
+        template<typename E>
+        constexpr
+        derived_type& operator-=(linear_expression<E, D, K> const& other) noexcept;
+#endif
+
         constexpr
         derived_type& derived() noexcept;
 
@@ -43,6 +72,7 @@ namespace geo
         derived_type const& derived() const noexcept;
     };
 
+#ifndef GEO_EXPRESSION_TEMPLATES
     template<typename D, typename K>
     constexpr
     D operator+(linear_operations<D, K> const& a) noexcept;
@@ -75,6 +105,7 @@ namespace geo
     constexpr
     D operator/(linear_operations<D, K> const& a,
                 typename linear_operations<D, K>::scalar_type k);
+#endif
 }
 
 #include "linear_operations.ipp"
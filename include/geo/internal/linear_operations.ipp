@@ -23,6 +23,7 @@ namespace geo
 
     // Direction ---------------------------------------------------------------
 
+#ifndef GEO_EXPRESSION_TEMPLATES
     template<typename D, typename K>
     constexpr
     D operator+(linear_operations<D, K> const& a) noexcept
@@ -35,11 +36,13 @@ namespace geo
     D operator-(linear_operations<D, K> const& a) noexcept
     {
         D result = a.derived();
-        for (auto& element : result) {
-            element = -element;
+        auto* const lanes = result.data();
+        for (unsigned i = 0; i < linear_operations<D, K>::storage_dimension; ++i) {
+            lanes[i] = -lanes[i];
         }
         return result;
     }
+#endif
 
     // Translation -------------------------------------------------------------
 
@@ -49,8 +52,10 @@ namespace geo
     -> derived_type&
     {
         derived_type& self = derived();
-        for (unsigned i = 0; i < dimension; ++i) {
-            self[i] += other[i];
+        auto* const lanes = self.data();
+        auto const* const other_lanes = other.data();
+        for (unsigned i = 0; i < storage_dimension; ++i) {
+            lanes[i] += other_lanes[i];
         }
         return self;
     }
@@ -61,12 +66,49 @@ namespace geo
     -> derived_type&
     {
         derived_type& self = derived();
-        for (unsigned i = 0; i < dimension; ++i) {
-            self[i] -= other[i];
+        auto* const lanes = self.data();
+        auto const* const other_lanes = other.data();
+        for (unsigned i = 0; i < storage_dimension; ++i) {
+            lanes[i] -= other_lanes[i];
         }
         return self;
     }
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+    template<typename D, typename K>
+    template<typename E>
+    constexpr
+    auto linear_operations<D, K>::operator+=(linear_expression<E, D, K> const& other) noexcept
+    -> derived_type&
+    {
+        constexpr unsigned lanes_count = E::padding_safe ? storage_dimension : dimension;
+
+        derived_type& self = derived();
+        auto* const lanes = self.data();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] += e.lane(i);
+        }
+        return self;
+    }
+
+    template<typename D, typename K>
+    template<typename E>
+    constexpr
+    auto linear_operations<D, K>::operator-=(linear_expression<E, D, K> const& other) noexcept
+    -> derived_type&
+    {
+        constexpr unsigned lanes_count = E::padding_safe ? storage_dimension : dimension;
+
+        derived_type& self = derived();
+        auto* const lanes = self.data();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] -= e.lane(i);
+        }
+        return self;
+    }
+#else
     template<typename D, typename K>
     constexpr
     D operator+(linear_operations<D, K> const& a,
@@ -82,6 +124,7 @@ namespace geo
     {
         return D(a.derived()) -= b.derived();
     }
+#endif
 
     // Scaling -----------------------------------------------------------------
 
@@ -89,9 +132,15 @@ namespace geo
     constexpr
     auto linear_operations<D, K>::operator*=(scalar_type k) noexcept -> derived_type&
     {
+        // Padding lanes are scaled along so that the loop covers whole
+        // registers, then reset as zero times an infinite k is NaN.
         derived_type& self = derived();
-        for (scalar_type& element : self) {
-            element *= k;
+        scalar_type* const lanes = self.data();
+        for (unsigned i = 0; i < storage_dimension; ++i) {
+            lanes[i] *= k;
+        }
+        for (unsigned i = dimension; i < storage_dimension; ++i) {
+            lanes[i] = scalar_type(0);
         }
         return self;
     }
@@ -107,6 +156,7 @@ namespace geo
         return self;
     }
 
+#ifndef GEO_EXPRESSION_TEMPLATES
     template<typename D, typename K>
     constexpr
     D operator*(linear_operations<D, K> const& a,
@@ -130,4 +180,5 @@ namespace geo
     {
         return D(a.derived()) /= k;
     }
+#endif
 }
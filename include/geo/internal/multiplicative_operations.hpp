@@ -8,18 +8,28 @@
 #ifndef GEO_INTERNAL_MULTIPLICATIVE_OPERATIONS_HPP
 #define GEO_INTERNAL_MULTIPLICATIVE_OPERATIONS_HPP
 
+#include "basic_coordinates.hpp"
+
+#ifdef GEO_EXPRESSION_TEMPLATES
+# include "linear_expressions.hpp"
+#endif
+
 namespace geo
 {
     /**
      * CRTP mixin for implementing multiplications on D.
      *
      * This class implements multiplication and division on class D.
+     * Multiplication runs over all storage lanes and division over the
+     * meaningful lanes only, as in linear_operations.
      */
     template<typename D, typename K>
     struct multiplicative_operations
     {
         using derived_type = D;
         static constexpr unsigned dimension = K::dimension;
+        static constexpr unsigned storage_dimension =
+            detail::storage_dimension_of<K>::value;
 
         constexpr
         derived_type& operator*=(derived_type const& other) noexcept;
@@ -27,6 +37,16 @@ namespace geo
         constexpr
         derived_type& operator/=(derived_type const& other);
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+        template<typename E>
+        constexpr
+        derived_type& operator*=(linear_expression<E, D, K> const& other) noexcept;
+
+        template<typename E>
+        constexpr
+        derived_type& operator/=(linear_expression<E, D, K> const& other);
+#endif
+
         constexpr
         derived_type& derived() noexcept;
 
@@ -34,6 +54,7 @@ namespace geo
         derived_type const& derived() const noexcept;
     };
 
+#ifndef GEO_EXPRESSION_TEMPLATES
     template<typename D, typename K>
     constexpr
     D operator*(multiplicative_operations<D, K> const& a,
@@ -43,6 +64,7 @@ namespace geo
     constexpr
     D operator/(multiplicative_operations<D, K> const& a,
                 multiplicative_operations<D, K> const& b);
+#endif
 }
 
 #include "multiplicative_operations.ipp"
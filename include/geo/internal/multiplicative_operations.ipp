@@ -29,8 +29,10 @@ namespace geo
     -> derived_type&
     {
         derived_type& self = derived();
-        for (unsigned i = 0; i < dimension; ++i) {
-            self[i] *= other[i];
+        auto* const lanes = self.data();
+        auto const* const other_lanes = other.data();
+        for (unsigned i = 0; i < storage_dimension; ++i) {
+            lanes[i] *= other_lanes[i];
         }
         return self;
     }
@@ -47,6 +49,38 @@ namespace geo
         return self;
     }
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+    template<typename D, typename K>
+    template<typename E>
+    constexpr
+    auto multiplicative_operations<D, K>::operator*=(linear_expression<E, D, K> const& other) noexcept
+    -> derived_type&
+    {
+        constexpr unsigned lanes_count = E::padding_safe ? storage_dimension : dimension;
+
+        derived_type& self = derived();
+        auto* const lanes = self.data();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] *= e.lane(i);
+        }
+        return self;
+    }
+
+    template<typename D, typename K>
+    template<typename E>
+    constexpr
+    auto multiplicative_operations<D, K>::operator/=(linear_expression<E, D, K> const& other)
+    -> derived_type&
+    {
+        derived_type& self = derived();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < dimension; ++i) {
+            self[i] /= e.lane(i);
+        }
+        return self;
+    }
+#else
     template<typename D, typename K>
     constexpr
     D operator*(multiplicative_operations<D, K> const& a,
@@ -62,4 +96,5 @@ namespace geo
     {
         return D(a.derived()) /= b.derived();
     }
+#endif
 }
@@ -0,0 +1,97 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// SIMD kernels over structure-of-arrays coordinate blocks.
+//
+// Kernels are written once against GCC vector extensions and compiled for
+// several instruction sets via function target attributes. The widest set
+// supported by the running CPU is picked at runtime. Define GEO_DISABLE_SIMD
+// to force the portable scalar code.
+//
+
+#ifndef GEO_INTERNAL_SIMD_HPP
+#define GEO_INTERNAL_SIMD_HPP
+
+#include <cstddef>
+
+#if !defined(GEO_DISABLE_SIMD) && \
+    (defined(__GNUC__) || defined(__clang__)) && \
+    (defined(__x86_64__) || defined(__i386__))
+# define GEO_SIMD_X86 1
+#else
+# define GEO_SIMD_X86 0
+#endif
+
+namespace geo
+{
+    namespace detail
+    {
+        /*
+         * Instruction sets, ordered by preference.
+         */
+        enum class simd_isa
+        {
+            scalar,
+            sse2,
+            avx2,
+            avx512
+        };
+
+        /*
+         * Returns the widest instruction set supported by the running CPU.
+         * The detection runs once and the result is cached.
+         */
+        inline
+        simd_isa active_simd_isa() noexcept;
+
+        /*
+         * Computes out[i] = sum_d (axes[d][i] - q[d])^2 for i in [0, n).
+         * Coordinates of type T are converted to M before subtraction, so M
+         * may be wider than T.
+         */
+        template<typename T, unsigned N, typename M = T>
+        void simd_squared_distances(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept;
+
+        /*
+         * Computes out[i] = sum_d axes[d][i] * u[d] for i in [0, n) with
+         * products accumulated in M.
+         */
+        template<typename T, unsigned N, typename M = T>
+        void simd_inner_products(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept;
+
+        /*
+         * Computes sum_i (M(a[i]) - M(b[i]))^2 for i in [0, n). The loop
+         * runs over whole registers regardless of n, with a scalar tail.
+         */
+        template<typename T, typename M = T>
+        M simd_squared_distance(T const* a, T const* b, std::size_t n) noexcept;
+
+        /*
+         * Computes sum_i M(a[i]) * M(b[i]) for i in [0, n).
+         */
+        template<typename T, typename M = T>
+        M simd_inner_product(T const* a, T const* b, std::size_t n) noexcept;
+
+        /*
+         * Approximates the closest points on an ellipsoid of the points
+         * axes[.][i] with i in [0, n), in the frame set up by
+         * ellipsoid_frame. Each point takes the same fixed number of Newton
+         * steps on its secular equation from its lower bound, so that lanes
+         * never diverge. The root is written to roots[i] and the coordinate
+         * of the foot along axis d to feet[d][i]. converged[i] is set to
+         * zero if the last step was still too long to trust the root.
+         */
+        template<typename T, unsigned N, typename M>
+        void simd_ellipsoid_feet(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept;
+    }
+}
+
+#include "simd.ipp"
+
+#endif
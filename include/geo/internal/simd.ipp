@@ -0,0 +1,878 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <type_traits>
+
+#include "simd.hpp"
+
+#if GEO_SIMD_X86
+# include <immintrin.h>
+#endif
+
+namespace geo
+{
+    namespace detail
+    {
+        // Portable kernels ----------------------------------------------------
+
+        template<typename T, unsigned N, typename M>
+        void scalar_squared_distances(T const* q, T const* const* axes,
+                                      std::size_t n, M* out) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                M sum = 0;
+                for (unsigned d = 0; d < N; ++d) {
+                    M const diff = M(axes[d][i]) - M(q[d]);
+                    sum += diff * diff;
+                }
+                out[i] = sum;
+            }
+        }
+
+        template<typename T, unsigned N, typename M>
+        void scalar_inner_products(T const* u, T const* const* axes,
+                                   std::size_t n, M* out) noexcept
+        {
+            for (std::size_t i = 0; i < n; ++i) {
+                M sum = 0;
+                for (unsigned d = 0; d < N; ++d) {
+                    sum += M(axes[d][i]) * M(u[d]);
+                }
+                out[i] = sum;
+            }
+        }
+
+        template<typename T, typename M>
+        M scalar_squared_distance(T const* a, T const* b, std::size_t n) noexcept
+        {
+            M sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                M const diff = M(a[i]) - M(b[i]);
+                sum += diff * diff;
+            }
+            return sum;
+        }
+
+        template<typename T, typename M>
+        M scalar_inner_product(T const* a, T const* b, std::size_t n) noexcept
+        {
+            M sum = 0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += M(a[i]) * M(b[i]);
+            }
+            return sum;
+        }
+
+        // Number of Newton steps taken by simd_ellipsoid_feet(). Steps from
+        // the lower bound converge quadratically once close to the root, so
+        // this settles nearly every point but those close to the medial
+        // plane of the shortest axis.
+        constexpr unsigned ellipsoid_newton_steps = 6;
+
+        // A root is trusted if the last step moved it by less than this
+        // fraction, since the error left after a quadratically converging
+        // step is of the order of the square of the step.
+        template<typename M>
+        M ellipsoid_step_tolerance() noexcept
+        {
+            return std::sqrt(std::numeric_limits<M>::epsilon());
+        }
+
+        template<typename T, unsigned N, typename M>
+        void scalar_ellipsoid_feet(M const* center, M const* semiaxes,
+                                   M const* gaps, T const* const* axes,
+                                   std::size_t n, M* roots, M* const* feet,
+                                   unsigned char* converged) noexcept
+        {
+            M const tolerance = ellipsoid_step_tolerance<M>();
+
+            for (std::size_t i = 0; i < n; ++i) {
+                M u[N];
+                M s = 0;
+                for (unsigned d = 0; d < N; ++d) {
+                    M const r = M(axes[d][i]) - center[d];
+                    u[d] = semiaxes[d] * (r < 0 ? -r : r);
+                    s = std::max(s, u[d] - gaps[d]);
+                }
+
+                M step = 0;
+                for (unsigned k = 0; k < ellipsoid_newton_steps; ++k) {
+                    M sum = 0;
+                    M slope = 0;
+                    for (unsigned d = 0; d < N; ++d) {
+                        M const den = s + gaps[d];
+                        M const inv = den > 0 ? M(1) / den : M(0);
+                        M const w = u[d] * inv;
+                        sum += w * w;
+                        slope += w * w * inv;
+                    }
+                    step = slope > 0 ? (std::sqrt(sum) - 1) * sum / slope : M(0);
+                    if (step > 0) {
+                        s += step;
+                    }
+                }
+
+                for (unsigned d = 0; d < N; ++d) {
+                    M const den = s + gaps[d];
+                    feet[d][i] = den > 0 ? semiaxes[d] * u[d] / den : M(0);
+                }
+                roots[i] = s;
+                converged[i] = step <= tolerance * s;
+            }
+        }
+    }
+
+#if GEO_SIMD_X86
+
+    namespace detail
+    {
+        // Instruction set detection -------------------------------------------
+
+        inline
+        simd_isa detect_simd_isa() noexcept
+        {
+            __builtin_cpu_init();
+            if (__builtin_cpu_supports("avx512f")) {
+                return simd_isa::avx512;
+            }
+            if (__builtin_cpu_supports("avx2")) {
+                return simd_isa::avx2;
+            }
+            if (__builtin_cpu_supports("sse2")) {
+                return simd_isa::sse2;
+            }
+            return simd_isa::scalar;
+        }
+
+        inline
+        simd_isa active_simd_isa() noexcept
+        {
+            static simd_isa const isa = detect_simd_isa();
+            return isa;
+        }
+
+        // Width-generic kernels -----------------------------------------------
+
+        // Register of Bytes bytes holding scalars of type T.
+        template<typename T, std::size_t Bytes>
+        struct simd_register
+        {
+            typedef T type __attribute__((vector_size(Bytes)));
+            static constexpr std::size_t width = Bytes / sizeof(T);
+        };
+
+        // Loads as many consecutive scalars at src as a register of M holds
+        // into dest, converting them if T is narrower than M. The conversion
+        // is a no-op if T and M are the same.
+        template<typename M, std::size_t Bytes, typename T>
+        __attribute__((always_inline)) inline
+        void load_widened(typename simd_register<M, Bytes>::type& dest,
+                          T const* src) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            using narrow = typename simd_register<
+                T, simd_register<M, Bytes>::width * sizeof(T)
+            >::type;
+
+            narrow x;
+            std::memcpy(&x, src, sizeof x);
+            dest = __builtin_convertvector(x, reg);
+        }
+
+        // These bodies contain no target-specific code. They are forcibly
+        // inlined into the target-attributed entry points below, so the
+        // compiler lowers the generic vector operations to the instruction
+        // set of each entry point. Lanes are accumulated in the same order
+        // as the scalar kernels, but the results may differ in the last bit
+        // where the instruction set provides fused multiply-add. Registers
+        // hold the accumulation type M, so a register of Bytes bytes reads
+        // fewer scalars per iteration when T is narrower than M.
+
+        template<std::size_t Bytes, typename T, unsigned N, typename M>
+        __attribute__((always_inline)) inline
+        void squared_distances_body(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            constexpr std::size_t width = simd_register<M, Bytes>::width;
+
+            reg qs[N];
+            for (unsigned d = 0; d < N; ++d) {
+                qs[d] = reg{} + M(q[d]);
+            }
+
+            std::size_t i = 0;
+            for (; i + width <= n; i += width) {
+                reg sum = {};
+                for (unsigned d = 0; d < N; ++d) {
+                    reg x;
+                    load_widened<M, Bytes>(x, axes[d] + i);
+                    reg const diff = x - qs[d];
+                    sum += diff * diff;
+                }
+                std::memcpy(out + i, &sum, sizeof sum);
+            }
+
+            T const* tail_axes[N];
+            for (unsigned d = 0; d < N; ++d) {
+                tail_axes[d] = axes[d] + i;
+            }
+            scalar_squared_distances<T, N, M>(q, tail_axes, n - i, out + i);
+        }
+
+        template<std::size_t Bytes, typename T, unsigned N, typename M>
+        __attribute__((always_inline)) inline
+        void inner_products_body(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            constexpr std::size_t width = simd_register<M, Bytes>::width;
+
+            reg us[N];
+            for (unsigned d = 0; d < N; ++d) {
+                us[d] = reg{} + M(u[d]);
+            }
+
+            std::size_t i = 0;
+            for (; i + width <= n; i += width) {
+                reg sum = {};
+                for (unsigned d = 0; d < N; ++d) {
+                    reg x;
+                    load_widened<M, Bytes>(x, axes[d] + i);
+                    sum += x * us[d];
+                }
+                std::memcpy(out + i, &sum, sizeof sum);
+            }
+
+            T const* tail_axes[N];
+            for (unsigned d = 0; d < N; ++d) {
+                tail_axes[d] = axes[d] + i;
+            }
+            scalar_inner_products<T, N, M>(u, tail_axes, n - i, out + i);
+        }
+
+        // Reductions over long tuples keep this many independent register
+        // sums, so that consecutive additions do not wait for each other.
+        constexpr unsigned reduction_accumulators = 4;
+
+        // Sums the lanes of a register by adding its halves until it fits in
+        // 16 bytes, which takes fewer dependent additions than a lane loop.
+        template<typename M, std::size_t Bytes, bool Split = (Bytes > 16)>
+        struct lane_sum
+        {
+            __attribute__((always_inline)) static inline
+            M apply(typename simd_register<M, Bytes>::type const& x) noexcept
+            {
+                typename simd_register<M, Bytes / 2>::type low;
+                typename simd_register<M, Bytes / 2>::type high;
+                std::memcpy(&low, &x, sizeof low);
+                std::memcpy(&high, reinterpret_cast<char const*>(&x) + sizeof low,
+                            sizeof high);
+                return lane_sum<M, Bytes / 2>::apply(low + high);
+            }
+        };
+
+        template<typename M, std::size_t Bytes>
+        struct lane_sum<M, Bytes, false>
+        {
+            __attribute__((always_inline)) static inline
+            M apply(typename simd_register<M, Bytes>::type const& x) noexcept
+            {
+                M sum = 0;
+                for (std::size_t j = 0; j < simd_register<M, Bytes>::width; ++j) {
+                    sum += x[j];
+                }
+                return sum;
+            }
+        };
+
+        template<std::size_t Bytes, typename M>
+        __attribute__((always_inline)) inline
+        M horizontal_sum(typename simd_register<M, Bytes>::type const* sums) noexcept
+        {
+            typename simd_register<M, Bytes>::type total = sums[0];
+            for (unsigned k = 1; k < reduction_accumulators; ++k) {
+                total += sums[k];
+            }
+            return lane_sum<M, Bytes>::apply(total);
+        }
+
+        template<std::size_t Bytes, typename T, typename M>
+        __attribute__((always_inline)) inline
+        M squared_distance_body(T const* a, T const* b, std::size_t n) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            constexpr std::size_t width = simd_register<M, Bytes>::width;
+            constexpr std::size_t stride = reduction_accumulators * width;
+
+            reg sums[reduction_accumulators] = {};
+            std::size_t i = 0;
+            for (; i + stride <= n; i += stride) {
+                for (unsigned k = 0; k < reduction_accumulators; ++k) {
+                    reg x;
+                    reg y;
+                    load_widened<M, Bytes>(x, a + i + k * width);
+                    load_widened<M, Bytes>(y, b + i + k * width);
+                    reg const diff = x - y;
+                    sums[k] += diff * diff;
+                }
+            }
+            for (; i + width <= n; i += width) {
+                reg x;
+                reg y;
+                load_widened<M, Bytes>(x, a + i);
+                load_widened<M, Bytes>(y, b + i);
+                reg const diff = x - y;
+                sums[0] += diff * diff;
+            }
+
+            return horizontal_sum<Bytes, M>(sums) +
+                   scalar_squared_distance<T, M>(a + i, b + i, n - i);
+        }
+
+        template<std::size_t Bytes, typename T, typename M>
+        __attribute__((always_inline)) inline
+        M inner_product_body(T const* a, T const* b, std::size_t n) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            constexpr std::size_t width = simd_register<M, Bytes>::width;
+            constexpr std::size_t stride = reduction_accumulators * width;
+
+            reg sums[reduction_accumulators] = {};
+            std::size_t i = 0;
+            for (; i + stride <= n; i += stride) {
+                for (unsigned k = 0; k < reduction_accumulators; ++k) {
+                    reg x;
+                    reg y;
+                    load_widened<M, Bytes>(x, a + i + k * width);
+                    load_widened<M, Bytes>(y, b + i + k * width);
+                    sums[k] += x * y;
+                }
+            }
+            for (; i + width <= n; i += width) {
+                reg x;
+                reg y;
+                load_widened<M, Bytes>(x, a + i);
+                load_widened<M, Bytes>(y, b + i);
+                sums[0] += x * y;
+            }
+
+            return horizontal_sum<Bytes, M>(sums) +
+                   scalar_inner_product<T, M>(a + i, b + i, n - i);
+        }
+
+        // Square roots of every lane. The standard functions may set errno,
+        // which keeps them from being vectorized, so the instructions are
+        // called directly. These are not forcibly inlined: a function with
+        // a target attribute cannot be inlined into the generic bodies, but
+        // it is inlined into the target-attributed entry points once the
+        // bodies are.
+
+        __attribute__((target("sse2")))
+        inline
+        void lane_sqrt(simd_register<float, 16>::type& x) noexcept
+        {
+            x = (simd_register<float, 16>::type) _mm_sqrt_ps((__m128) x);
+        }
+
+        __attribute__((target("sse2")))
+        inline
+        void lane_sqrt(simd_register<double, 16>::type& x) noexcept
+        {
+            x = (simd_register<double, 16>::type) _mm_sqrt_pd((__m128d) x);
+        }
+
+        __attribute__((target("avx")))
+        inline
+        void lane_sqrt(simd_register<float, 32>::type& x) noexcept
+        {
+            x = (simd_register<float, 32>::type) _mm256_sqrt_ps((__m256) x);
+        }
+
+        __attribute__((target("avx")))
+        inline
+        void lane_sqrt(simd_register<double, 32>::type& x) noexcept
+        {
+            x = (simd_register<double, 32>::type) _mm256_sqrt_pd((__m256d) x);
+        }
+
+        __attribute__((target("avx512f")))
+        inline
+        void lane_sqrt(simd_register<float, 64>::type& x) noexcept
+        {
+            __m512 const y = (__m512) x;
+            x = (simd_register<float, 64>::type) _mm512_mask_sqrt_ps(y, 0xffff, y);
+        }
+
+        __attribute__((target("avx512f")))
+        inline
+        void lane_sqrt(simd_register<double, 64>::type& x) noexcept
+        {
+            __m512d const y = (__m512d) x;
+            x = (simd_register<double, 64>::type) _mm512_mask_sqrt_pd(y, 0xff, y);
+        }
+
+        // Same steps as scalar_ellipsoid_feet(). Lanes whose step turns
+        // negative, because their root is below the starting bound, keep
+        // their value through the remaining steps.
+        //
+        // A step depends on the previous one through a chain of divisions
+        // and a square root, so every step is taken on up to chains
+        // independent registers before the next one, which lets the
+        // processor overlap their latencies.
+        template<std::size_t Bytes, typename T, unsigned N, typename M>
+        __attribute__((always_inline)) inline
+        void ellipsoid_feet_body(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept
+        {
+            using reg = typename simd_register<M, Bytes>::type;
+            constexpr std::size_t width = simd_register<M, Bytes>::width;
+            constexpr std::size_t chains = 8;
+
+            reg cs[N];
+            reg as[N];
+            reg gs[N];
+            for (unsigned d = 0; d < N; ++d) {
+                cs[d] = reg{} + center[d];
+                as[d] = reg{} + semiaxes[d];
+                gs[d] = reg{} + gaps[d];
+            }
+            reg const zero = {};
+            reg const one = zero + M(1);
+            reg const tolerance = zero + ellipsoid_step_tolerance<M>();
+
+            std::size_t i = 0;
+            while (i + width <= n) {
+                std::size_t const count = std::min(chains, (n - i) / width);
+
+                reg u[N][chains];
+                reg s[chains];
+                reg step[chains];
+                for (std::size_t j = 0; j < count; ++j) {
+                    s[j] = zero;
+                    step[j] = zero;
+                    for (unsigned d = 0; d < N; ++d) {
+                        reg x;
+                        load_widened<M, Bytes>(x, axes[d] + i + j * width);
+                        reg const r = x - cs[d];
+                        u[d][j] = as[d] * (r < zero ? -r : r);
+                        reg const bound = u[d][j] - gs[d];
+                        s[j] = bound > s[j] ? bound : s[j];
+                    }
+                }
+
+                for (unsigned k = 0; k < ellipsoid_newton_steps; ++k) {
+                    for (std::size_t j = 0; j < count; ++j) {
+                        reg sum = zero;
+                        reg slope = zero;
+                        for (unsigned d = 0; d < N; ++d) {
+                            reg const den = s[j] + gs[d];
+                            reg const inv = den > zero ? one / den : zero;
+                            reg const w = u[d][j] * inv;
+                            sum += w * w;
+                            slope += w * w * inv;
+                        }
+                        reg root = sum;
+                        lane_sqrt(root);
+                        step[j] = slope > zero ? (root - one) * sum / slope : zero;
+                        s[j] = step[j] > zero ? s[j] + step[j] : s[j];
+                    }
+                }
+
+                for (std::size_t j = 0; j < count; ++j) {
+                    for (unsigned d = 0; d < N; ++d) {
+                        reg const den = s[j] + gs[d];
+                        reg const foot = den > zero ? as[d] * u[d][j] / den : zero;
+                        std::memcpy(feet[d] + i + j * width, &foot, sizeof foot);
+                    }
+                    std::memcpy(roots + i + j * width, &s[j], sizeof s[j]);
+                    auto const done = step[j] <= tolerance * s[j];
+                    for (std::size_t k = 0; k < width; ++k) {
+                        converged[i + j * width + k] = done[k] != 0;
+                    }
+                }
+                i += count * width;
+            }
+
+            T const* tail_axes[N];
+            M* tail_feet[N];
+            for (unsigned d = 0; d < N; ++d) {
+                tail_axes[d] = axes[d] + i;
+                tail_feet[d] = feet[d] + i;
+            }
+            scalar_ellipsoid_feet<T, N, M>(center, semiaxes, gaps, tail_axes, n - i,
+                                           roots + i, tail_feet, converged + i);
+        }
+
+        // Target-specific entry points ----------------------------------------
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("sse2")))
+        void squared_distances_sse2(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept
+        {
+            squared_distances_body<16, T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx2,fma")))
+        void squared_distances_avx2(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept
+        {
+            squared_distances_body<32, T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx512f")))
+        void squared_distances_avx512(T const* q, T const* const* axes,
+                                      std::size_t n, M* out) noexcept
+        {
+            squared_distances_body<64, T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("sse2")))
+        void inner_products_sse2(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept
+        {
+            inner_products_body<16, T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx2,fma")))
+        void inner_products_avx2(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept
+        {
+            inner_products_body<32, T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx512f")))
+        void inner_products_avx512(T const* u, T const* const* axes,
+                                   std::size_t n, M* out) noexcept
+        {
+            inner_products_body<64, T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("sse2")))
+        M squared_distance_sse2(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return squared_distance_body<16, T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("avx2,fma")))
+        M squared_distance_avx2(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return squared_distance_body<32, T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("avx512f")))
+        M squared_distance_avx512(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return squared_distance_body<64, T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("sse2")))
+        M inner_product_sse2(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return inner_product_body<16, T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("avx2,fma")))
+        M inner_product_avx2(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return inner_product_body<32, T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        __attribute__((target("avx512f")))
+        M inner_product_avx512(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return inner_product_body<64, T, M>(a, b, n);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("sse2")))
+        void ellipsoid_feet_sse2(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept
+        {
+            ellipsoid_feet_body<16, T, N, M>(center, semiaxes, gaps, axes, n,
+                                             roots, feet, converged);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx2,fma")))
+        void ellipsoid_feet_avx2(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept
+        {
+            ellipsoid_feet_body<32, T, N, M>(center, semiaxes, gaps, axes, n,
+                                             roots, feet, converged);
+        }
+
+        template<typename T, unsigned N, typename M>
+        __attribute__((target("avx512f")))
+        void ellipsoid_feet_avx512(M const* center, M const* semiaxes,
+                                   M const* gaps, T const* const* axes,
+                                   std::size_t n, M* roots, M* const* feet,
+                                   unsigned char* converged) noexcept
+        {
+            ellipsoid_feet_body<64, T, N, M>(center, semiaxes, gaps, axes, n,
+                                             roots, feet, converged);
+        }
+
+        // Dispatch ------------------------------------------------------------
+
+        template<typename T>
+        struct is_simd_scalar
+            : std::integral_constant<bool, std::is_same<T, float>::value ||
+                                           std::is_same<T, double>::value>
+        {
+        };
+
+        // Vector kernels read T and accumulate in M, which must be the same
+        // type or wider.
+        template<typename T, typename M>
+        struct is_simd_pair
+            : std::integral_constant<bool, is_simd_scalar<T>::value &&
+                                           is_simd_scalar<M>::value &&
+                                           sizeof(T) <= sizeof(M)>
+        {
+        };
+
+        template<typename T, unsigned N, typename M>
+        void simd_squared_distances(T const* q, T const* const* axes,
+                                    std::size_t n, M* out,
+                                    std::true_type) noexcept
+        {
+            switch (active_simd_isa()) {
+              case simd_isa::avx512:
+                return squared_distances_avx512<T, N, M>(q, axes, n, out);
+              case simd_isa::avx2:
+                return squared_distances_avx2<T, N, M>(q, axes, n, out);
+              case simd_isa::sse2:
+                return squared_distances_sse2<T, N, M>(q, axes, n, out);
+              case simd_isa::scalar:
+                break;
+            }
+            scalar_squared_distances<T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_squared_distances(T const* q, T const* const* axes,
+                                    std::size_t n, M* out,
+                                    std::false_type) noexcept
+        {
+            scalar_squared_distances<T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_squared_distances(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept
+        {
+            simd_squared_distances<T, N, M>(q, axes, n, out, is_simd_pair<T, M>{});
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_inner_products(T const* u, T const* const* axes,
+                                 std::size_t n, M* out,
+                                 std::true_type) noexcept
+        {
+            switch (active_simd_isa()) {
+              case simd_isa::avx512:
+                return inner_products_avx512<T, N, M>(u, axes, n, out);
+              case simd_isa::avx2:
+                return inner_products_avx2<T, N, M>(u, axes, n, out);
+              case simd_isa::sse2:
+                return inner_products_sse2<T, N, M>(u, axes, n, out);
+              case simd_isa::scalar:
+                break;
+            }
+            scalar_inner_products<T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_inner_products(T const* u, T const* const* axes,
+                                 std::size_t n, M* out,
+                                 std::false_type) noexcept
+        {
+            scalar_inner_products<T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_inner_products(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept
+        {
+            simd_inner_products<T, N, M>(u, axes, n, out, is_simd_pair<T, M>{});
+        }
+
+        template<typename T, typename M>
+        M simd_squared_distance(T const* a, T const* b, std::size_t n,
+                                std::true_type) noexcept
+        {
+            switch (active_simd_isa()) {
+              case simd_isa::avx512:
+                return squared_distance_avx512<T, M>(a, b, n);
+              case simd_isa::avx2:
+                return squared_distance_avx2<T, M>(a, b, n);
+              case simd_isa::sse2:
+                return squared_distance_sse2<T, M>(a, b, n);
+              case simd_isa::scalar:
+                break;
+            }
+            return scalar_squared_distance<T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        M simd_squared_distance(T const* a, T const* b, std::size_t n,
+                                std::false_type) noexcept
+        {
+            return scalar_squared_distance<T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        M simd_squared_distance(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return simd_squared_distance<T, M>(a, b, n, is_simd_pair<T, M>{});
+        }
+
+        template<typename T, typename M>
+        M simd_inner_product(T const* a, T const* b, std::size_t n,
+                             std::true_type) noexcept
+        {
+            switch (active_simd_isa()) {
+              case simd_isa::avx512:
+                return inner_product_avx512<T, M>(a, b, n);
+              case simd_isa::avx2:
+                return inner_product_avx2<T, M>(a, b, n);
+              case simd_isa::sse2:
+                return inner_product_sse2<T, M>(a, b, n);
+              case simd_isa::scalar:
+                break;
+            }
+            return scalar_inner_product<T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        M simd_inner_product(T const* a, T const* b, std::size_t n,
+                             std::false_type) noexcept
+        {
+            return scalar_inner_product<T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        M simd_inner_product(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return simd_inner_product<T, M>(a, b, n, is_simd_pair<T, M>{});
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_ellipsoid_feet(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged,
+                                 std::true_type) noexcept
+        {
+            switch (active_simd_isa()) {
+              case simd_isa::avx512:
+                return ellipsoid_feet_avx512<T, N, M>(center, semiaxes, gaps, axes,
+                                                      n, roots, feet, converged);
+              case simd_isa::avx2:
+                return ellipsoid_feet_avx2<T, N, M>(center, semiaxes, gaps, axes,
+                                                    n, roots, feet, converged);
+              case simd_isa::sse2:
+                return ellipsoid_feet_sse2<T, N, M>(center, semiaxes, gaps, axes,
+                                                    n, roots, feet, converged);
+              case simd_isa::scalar:
+                break;
+            }
+            scalar_ellipsoid_feet<T, N, M>(center, semiaxes, gaps, axes, n,
+                                           roots, feet, converged);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_ellipsoid_feet(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged,
+                                 std::false_type) noexcept
+        {
+            scalar_ellipsoid_feet<T, N, M>(center, semiaxes, gaps, axes, n,
+                                           roots, feet, converged);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_ellipsoid_feet(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept
+        {
+            simd_ellipsoid_feet<T, N, M>(center, semiaxes, gaps, axes, n, roots,
+                                         feet, converged, is_simd_pair<T, M>{});
+        }
+    }
+
+#else
+
+    namespace detail
+    {
+        inline
+        simd_isa active_simd_isa() noexcept
+        {
+            return simd_isa::scalar;
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_squared_distances(T const* q, T const* const* axes,
+                                    std::size_t n, M* out) noexcept
+        {
+            scalar_squared_distances<T, N, M>(q, axes, n, out);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_inner_products(T const* u, T const* const* axes,
+                                 std::size_t n, M* out) noexcept
+        {
+            scalar_inner_products<T, N, M>(u, axes, n, out);
+        }
+
+        template<typename T, typename M>
+        M simd_squared_distance(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return scalar_squared_distance<T, M>(a, b, n);
+        }
+
+        template<typename T, typename M>
+        M simd_inner_product(T const* a, T const* b, std::size_t n) noexcept
+        {
+            return scalar_inner_product<T, M>(a, b, n);
+        }
+
+        template<typename T, unsigned N, typename M>
+        void simd_ellipsoid_feet(M const* center, M const* semiaxes,
+                                 M const* gaps, T const* const* axes,
+                                 std::size_t n, M* roots, M* const* feet,
+                                 unsigned char* converged) noexcept
+        {
+            scalar_ellipsoid_feet<T, N, M>(center, semiaxes, gaps, axes, n,
+                                           roots, feet, converged);
+        }
+    }
+
+#endif
+}
@@ -0,0 +1,150 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Static k-d tree of points.
+//
+
+#ifndef GEO_KD_TREE_HPP
+#define GEO_KD_TREE_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "box.hpp"
+#include "point.hpp"
+#include "sphere.hpp"
+
+namespace geo
+{
+    /**
+     * Balanced k-d tree built once from a range of points.
+     *
+     * Nodes are stored in a flat array in depth-first order: the left child
+     * of a node immediately follows it and the right child is referred to by
+     * index. Points are reordered so that every node covers a contiguous
+     * range of points. Each node keeps the tight bounding box of its points,
+     * which is used to prune queries.
+     *
+     * Points are identified by their index in the range the tree was built
+     * from.
+     */
+    template<typename K>
+    struct kd_tree
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type of node bounds.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Type of range query.
+         */
+        using sphere_type = sphere<K>;
+
+        /**
+         * Type for indices of points.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        /**
+         * Maximum number of points stored in a leaf node.
+         */
+        static constexpr std::size_t leaf_size = 8;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty tree.
+         */
+        kd_tree() = default;
+
+        /**
+         * Builds a tree of points in given range.
+         */
+        template<typename Iterator>
+        kd_tree(Iterator first, Iterator last);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of points.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if the tree has no point.
+         */
+        bool empty() const noexcept;
+
+        // Query ---------------------------------------------------------------
+
+        /**
+         * Returns the index of the point nearest to p.
+         *
+         * Ties are broken arbitrarily. Assertion fails if the tree is empty.
+         */
+        index_type nearest(point_type const& p) const;
+
+        /**
+         * Writes the indices of the k points nearest to p to out, ordered
+         * from the nearest. Fewer indices are written if the tree has less
+         * than k points. Returns the end of the output range.
+         */
+        template<typename OutputIterator>
+        OutputIterator k_nearest(point_type const& p, std::size_t k,
+                                 OutputIterator out) const;
+
+        /**
+         * Writes the indices of points inside or on the sphere to out in
+         * unspecified order. Returns the end of the output range.
+         */
+        template<typename OutputIterator>
+        OutputIterator within(sphere_type const& s, OutputIterator out) const;
+
+      private:
+        struct node
+        {
+            box_type bounds;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t right;
+        };
+
+        std::size_t build(std::vector<point_type> const& source,
+                          std::size_t begin, std::size_t end);
+
+        std::vector<node> nodes_;
+        std::vector<index_type> indices_;
+        std::vector<point_type> points_;
+    };
+}
+
+#include "kd_tree.ipp"
+
+#endif
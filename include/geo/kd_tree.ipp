@@ -0,0 +1,290 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "kd_tree.hpp"
+#include "point.hpp"
+#include "sphere.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Depth-first traversal stack. Median splits keep the depth of a tree
+        // below 64, and a traversal holds at most one pending sibling per
+        // level.
+        template<typename T>
+        struct kd_tree_stack
+        {
+            static constexpr std::size_t capacity = 128;
+
+            void push(T const& item)
+            {
+                GEO_ASSERT(size < capacity);
+                items[size++] = item;
+            }
+
+            T pop()
+            {
+                return items[--size];
+            }
+
+            bool empty() const noexcept
+            {
+                return size == 0;
+            }
+
+            T items[capacity];
+            std::size_t size = 0;
+        };
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    template<typename Iterator>
+    kd_tree<K>::kd_tree(Iterator first, Iterator last)
+    {
+        std::vector<point_type> const source(first, last);
+        if (source.empty()) {
+            return;
+        }
+
+        indices_.resize(source.size());
+        std::iota(indices_.begin(), indices_.end(), index_type(0));
+        nodes_.reserve(2 * (source.size() / leaf_size + 1));
+        build(source, 0, source.size());
+
+        points_.reserve(source.size());
+        for (index_type const idx : indices_) {
+            points_.push_back(source[idx]);
+        }
+    }
+
+    template<typename K>
+    std::size_t kd_tree<K>::build(std::vector<point_type> const& source,
+                                  std::size_t begin, std::size_t end)
+    {
+        point_type low = source[indices_[begin]];
+        point_type high = low;
+        for (std::size_t i = begin + 1; i < end; ++i) {
+            point_type const& p = source[indices_[i]];
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                low[axis] = std::min(low[axis], p[axis]);
+                high[axis] = std::max(high[axis], p[axis]);
+            }
+        }
+
+        std::size_t const self = nodes_.size();
+        nodes_.push_back(node {box_type {low, high}, begin, end, 0});
+
+        if (end - begin <= leaf_size) {
+            return self;
+        }
+
+        // Split at the median along the longest side of the bounds.
+        auto const span = high - low;
+        unsigned split_axis = 0;
+        for (unsigned axis = 1; axis < dimension; ++axis) {
+            if (span[axis] > span[split_axis]) {
+                split_axis = axis;
+            }
+        }
+
+        std::size_t const mid = begin + (end - begin) / 2;
+        std::nth_element(
+            indices_.begin() + static_cast<std::ptrdiff_t>(begin),
+            indices_.begin() + static_cast<std::ptrdiff_t>(mid),
+            indices_.begin() + static_cast<std::ptrdiff_t>(end),
+            [&](index_type a, index_type b) {
+                return source[a][split_axis] < source[b][split_axis];
+            }
+        );
+
+        build(source, begin, mid);
+        std::size_t const right = build(source, mid, end);
+        nodes_[self].right = right;
+
+        return self;
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    std::size_t kd_tree<K>::size() const noexcept
+    {
+        return points_.size();
+    }
+
+    template<typename K>
+    bool kd_tree<K>::empty() const noexcept
+    {
+        return points_.empty();
+    }
+
+    // Query -------------------------------------------------------------------
+
+    // A node is a leaf if it has no right child. The root is never a right
+    // child, so zero works as the sentinel.
+
+    template<typename K>
+    auto kd_tree<K>::nearest(point_type const& p) const -> index_type
+    {
+        GEO_ASSERT(!empty());
+
+        using entry = std::pair<std::size_t, metric_type>;
+
+        metric_type best_distance = detail::unbounded_value<metric_type>();
+        std::size_t best = 0;
+
+        detail::kd_tree_stack<entry> stack;
+        stack.push(entry {0, squared_distance(nodes_[0].bounds, p)});
+
+        while (!stack.empty()) {
+            entry const top = stack.pop();
+            if (top.second > best_distance) {
+                continue;
+            }
+
+            node const& current = nodes_[top.first];
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    metric_type const d2 = squared_distance(points_[i], p);
+                    if (d2 < best_distance) {
+                        best_distance = d2;
+                        best = i;
+                    }
+                }
+                continue;
+            }
+
+            // Visit the closer child first by pushing it last.
+            entry near {top.first + 1, squared_distance(nodes_[top.first + 1].bounds, p)};
+            entry far {current.right, squared_distance(nodes_[current.right].bounds, p)};
+            if (far.second < near.second) {
+                std::swap(near, far);
+            }
+            if (far.second <= best_distance) {
+                stack.push(far);
+            }
+            if (near.second <= best_distance) {
+                stack.push(near);
+            }
+        }
+
+        return indices_[best];
+    }
+
+    template<typename K>
+    template<typename OutputIterator>
+    OutputIterator kd_tree<K>::k_nearest(point_type const& p, std::size_t k,
+                                         OutputIterator out) const
+    {
+        if (k == 0 || empty()) {
+            return out;
+        }
+
+        using candidate = std::pair<metric_type, std::size_t>;
+        using entry = std::pair<std::size_t, metric_type>;
+
+        // Bounded max-heap of the best candidates found so far.
+        std::vector<candidate> heap;
+        heap.reserve(std::min(k, size()));
+
+        auto const bound = [&] {
+            return heap.size() < k ? detail::unbounded_value<metric_type>()
+                                   : heap.front().first;
+        };
+
+        detail::kd_tree_stack<entry> stack;
+        stack.push(entry {0, squared_distance(nodes_[0].bounds, p)});
+
+        while (!stack.empty()) {
+            entry const top = stack.pop();
+            if (top.second > bound()) {
+                continue;
+            }
+
+            node const& current = nodes_[top.first];
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    metric_type const d2 = squared_distance(points_[i], p);
+                    if (heap.size() < k) {
+                        heap.emplace_back(d2, i);
+                        std::push_heap(heap.begin(), heap.end());
+                    } else if (d2 < heap.front().first) {
+                        std::pop_heap(heap.begin(), heap.end());
+                        heap.back() = candidate {d2, i};
+                        std::push_heap(heap.begin(), heap.end());
+                    }
+                }
+                continue;
+            }
+
+            entry near {top.first + 1, squared_distance(nodes_[top.first + 1].bounds, p)};
+            entry far {current.right, squared_distance(nodes_[current.right].bounds, p)};
+            if (far.second < near.second) {
+                std::swap(near, far);
+            }
+            if (far.second <= bound()) {
+                stack.push(far);
+            }
+            if (near.second <= bound()) {
+                stack.push(near);
+            }
+        }
+
+        std::sort_heap(heap.begin(), heap.end());
+        for (candidate const& c : heap) {
+            *out++ = indices_[c.second];
+        }
+        return out;
+    }
+
+    template<typename K>
+    template<typename OutputIterator>
+    OutputIterator kd_tree<K>::within(sphere_type const& s,
+                                      OutputIterator out) const
+    {
+        if (empty()) {
+            return out;
+        }
+
+        point_type const center = s.center();
+        metric_type const squared_radius = s.squared_radius();
+
+        detail::kd_tree_stack<std::size_t> stack;
+        stack.push(0);
+
+        while (!stack.empty()) {
+            std::size_t const index = stack.pop();
+            node const& current = nodes_[index];
+            if (squared_distance(current.bounds, center) > squared_radius) {
+                continue;
+            }
+
+            if (current.right == 0) {
+                for (std::size_t i = current.begin; i < current.end; ++i) {
+                    if (squared_distance(points_[i], center) <= squared_radius) {
+                        *out++ = indices_[i];
+                    }
+                }
+                continue;
+            }
+
+            stack.push(current.right);
+            stack.push(index + 1);
+        }
+
+        return out;
+    }
+}
@@ -0,0 +1,149 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// General linear transformation of vector.
+//
+
+#ifndef GEO_LINEAR_TRANSFORMATION_HPP
+#define GEO_LINEAR_TRANSFORMATION_HPP
+
+#include "scaling_transformation.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Function-like class for linear transformation of vector by a square
+     * matrix.
+     *
+     * Rotations are represented by orthogonal matrices. They are meant to
+     * be built once, with plane_rotation() and composition, and then applied
+     * to many vectors without any trigonometry.
+     */
+    template<typename K>
+    struct linear_transformation
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for vectors associated to the underlying Euclidean space.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Type of scaling transformation.
+         */
+        using scaling_type = scaling_transformation<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Default constructor creates an identity transformation.
+         */
+        constexpr
+        linear_transformation() noexcept;
+
+        /**
+         * Creates a transformation with the same effect as scaling.
+         */
+        constexpr
+        linear_transformation(scaling_type const& scaling) noexcept;
+
+        // Element access ------------------------------------------------------
+
+        /**
+         * Returns a reference to the matrix element at given row and column.
+         */
+        constexpr
+        scalar_type& element(unsigned row, unsigned col) noexcept;
+
+        constexpr
+        scalar_type const& element(unsigned row, unsigned col) const noexcept;
+
+        /**
+         * Returns a column of the matrix, that is, the image of the basis
+         * vector of given axis.
+         */
+        constexpr
+        vector_type column(unsigned col) const noexcept;
+
+        // Operation -----------------------------------------------------------
+
+        /**
+         * Transforms a vector.
+         */
+        constexpr
+        vector_type operator()(vector_type const& v) const noexcept;
+
+        /**
+         * Composes other transformation to the right of this.
+         */
+        constexpr
+        linear_transformation& operator*=(linear_transformation const& other) noexcept;
+
+        /**
+         * Multiplies all elements by a scalar.
+         */
+        constexpr
+        linear_transformation& operator*=(scalar_type k) noexcept;
+
+      private:
+        scalar_type matrix_[K::dimension][K::dimension] {};
+    };
+
+    /**
+     * Composes two transformations. The result applies b first and then a.
+     */
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(linear_transformation<K> const& a,
+                                       linear_transformation<K> const& b) noexcept;
+
+    /**
+     * Multiplies all elements of a transformation by a scalar.
+     */
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(typename K::scalar k,
+                                       linear_transformation<K> const& a) noexcept;
+
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(linear_transformation<K> const& a,
+                                       typename K::scalar k) noexcept;
+
+    /**
+     * Returns the transpose of a transformation. This is the inverse if the
+     * transformation is a rotation.
+     */
+    template<typename K>
+    constexpr
+    linear_transformation<K> transpose(linear_transformation<K> const& a) noexcept;
+
+    /**
+     * Returns the rotation by angle (in radians) in the plane spanned by two
+     * axes, turning the first axis toward the second. Assertion fails if the
+     * axes are the same or out of range.
+     */
+    template<typename K>
+    linear_transformation<K> plane_rotation(unsigned axis1, unsigned axis2,
+                                            typename K::scalar angle);
+}
+
+#include "linear_transformation.ipp"
+
+#endif
@@ -0,0 +1,167 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+
+#include "assert.hpp"
+#include "linear_transformation.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    constexpr
+    linear_transformation<K>::linear_transformation() noexcept
+        : linear_transformation(scaling_type {})
+    {
+    }
+
+    template<typename K>
+    constexpr
+    linear_transformation<K>::linear_transformation(scaling_type const& scaling) noexcept
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            matrix_[i][i] = scaling[i];
+        }
+    }
+
+    // Element access ----------------------------------------------------------
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::element(unsigned row, unsigned col) noexcept
+    -> scalar_type&
+    {
+        GEO_EXTRA_ASSERT(row < dimension && col < dimension);
+        return matrix_[row][col];
+    }
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::element(unsigned row, unsigned col) const noexcept
+    -> scalar_type const&
+    {
+        GEO_EXTRA_ASSERT(row < dimension && col < dimension);
+        return matrix_[row][col];
+    }
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::column(unsigned col) const noexcept -> vector_type
+    {
+        vector_type result;
+        for (unsigned i = 0; i < dimension; ++i) {
+            result[i] = matrix_[i][col];
+        }
+        return result;
+    }
+
+    // Operation ---------------------------------------------------------------
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::operator()(vector_type const& v) const noexcept
+    -> vector_type
+    {
+        // Accumulate columns so that the inner loop runs over contiguous lanes
+        // of the result.
+        vector_type result;
+        for (unsigned j = 0; j < dimension; ++j) {
+            for (unsigned i = 0; i < dimension; ++i) {
+                result[i] += matrix_[i][j] * v[j];
+            }
+        }
+        return result;
+    }
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::operator*=(linear_transformation const& other) noexcept
+    -> linear_transformation&
+    {
+        linear_transformation const self = *this;
+        for (unsigned i = 0; i < dimension; ++i) {
+            for (unsigned j = 0; j < dimension; ++j) {
+                scalar_type sum = 0;
+                for (unsigned k = 0; k < dimension; ++k) {
+                    sum += self.matrix_[i][k] * other.matrix_[k][j];
+                }
+                matrix_[i][j] = sum;
+            }
+        }
+        return *this;
+    }
+
+    template<typename K>
+    constexpr
+    auto linear_transformation<K>::operator*=(scalar_type k) noexcept
+    -> linear_transformation&
+    {
+        for (auto& row : matrix_) {
+            for (scalar_type& elem : row) {
+                elem *= k;
+            }
+        }
+        return *this;
+    }
+
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(linear_transformation<K> const& a,
+                                       linear_transformation<K> const& b) noexcept
+    {
+        linear_transformation<K> result = a;
+        result *= b;
+        return result;
+    }
+
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(typename K::scalar k,
+                                       linear_transformation<K> const& a) noexcept
+    {
+        linear_transformation<K> result = a;
+        result *= k;
+        return result;
+    }
+
+    template<typename K>
+    constexpr
+    linear_transformation<K> operator*(linear_transformation<K> const& a,
+                                       typename K::scalar k) noexcept
+    {
+        return k * a;
+    }
+
+    template<typename K>
+    constexpr
+    linear_transformation<K> transpose(linear_transformation<K> const& a) noexcept
+    {
+        linear_transformation<K> result;
+        for (unsigned i = 0; i < K::dimension; ++i) {
+            for (unsigned j = 0; j < K::dimension; ++j) {
+                result.element(i, j) = a.element(j, i);
+            }
+        }
+        return result;
+    }
+
+    template<typename K>
+    linear_transformation<K> plane_rotation(unsigned axis1, unsigned axis2,
+                                            typename K::scalar angle)
+    {
+        GEO_ASSERT(axis1 < K::dimension && axis2 < K::dimension);
+        GEO_ASSERT(axis1 != axis2);
+
+        auto const cos = std::cos(angle);
+        auto const sin = std::sin(angle);
+
+        linear_transformation<K> rotation;
+        rotation.element(axis1, axis1) = cos;
+        rotation.element(axis2, axis2) = cos;
+        rotation.element(axis2, axis1) = sin;
+        rotation.element(axis1, axis2) = -sin;
+        return rotation;
+    }
+}
@@ -0,0 +1,74 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Kernel storing coordinates in a narrower type than it measures in.
+//
+// This header has no inline implementation file (*.ipp).
+//
+
+#ifndef GEO_MIXED_PRECISION_KERNEL_HPP
+#define GEO_MIXED_PRECISION_KERNEL_HPP
+
+#include <cmath>
+#include <type_traits>
+
+#include "standard_kernel.hpp"
+
+namespace geo
+{
+    /**
+     * Kernel that stores coordinates in builtin floating point type T and
+     * measures distances and accumulates sums in a wider type M, for example
+     * T = float and M = double.
+     *
+     * Coordinates take sizeof(T) bytes each, so large point sets need less
+     * memory bandwidth, while inner products, squared distances and
+     * centroids are accumulated in M. Differences of coordinates converted
+     * to M are exact when M has at least twice the precision of T.
+     */
+    template<typename T, typename M, unsigned n, typename Storage = packed_storage>
+    struct mixed_precision_kernel
+    {
+        static_assert(std::is_floating_point<T>::value, "");
+        static_assert(std::is_floating_point<M>::value, "");
+        static_assert(sizeof(T) <= sizeof(M), "");
+        static_assert(n >= 1, "");
+        static_assert(std::is_same<Storage, packed_storage>::value ||
+                      std::is_same<Storage, padded_storage>::value, "");
+
+        /**
+         * Aliased to T.
+         */
+        using scalar = T;
+
+        /**
+         * Aliased to M.
+         */
+        using metric = M;
+
+        /**
+         * Set to n.
+         */
+        static constexpr unsigned dimension = n;
+
+        /**
+         * Number of scalars stored for a coordinate tuple. Set to n for
+         * packed_storage and to n rounded up to a power of two for
+         * padded_storage.
+         */
+        static constexpr unsigned storage_dimension =
+            std::is_same<Storage, padded_storage>::value
+                ? detail::next_power_of_two(n) : n;
+
+        /**
+         * Calls std::sqrt(x).
+         */
+        static metric sqrt(metric x) noexcept
+        {
+            return std::sqrt(x);
+        }
+    };
+}
+
+#endif
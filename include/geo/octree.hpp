@@ -0,0 +1,233 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Linear octree of weighted points with Barnes-Hut approximation.
+//
+
+#ifndef GEO_OCTREE_HPP
+#define GEO_OCTREE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "box.hpp"
+#include "execution.hpp"
+#include "internal/aligned_allocator.hpp"
+#include "pair_engine.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Static tree of weighted points in which every node has up to
+     * 2^dimension children: a quadtree in 2D and an octree in 3D.
+     *
+     * The tree is built from the points sorted by their Morton codes over
+     * the bounding box of the points. Each node covers a contiguous range
+     * of the sorted points sharing a prefix of their codes, and levels at
+     * which all points of a node fall into the same cell are skipped. Nodes
+     * are stored in a flat array where the children of a node are
+     * consecutive. Each node keeps the tight bounding box of its points, the
+     * sum of their masses and their mass-weighted centroid.
+     *
+     * energy() and forces() evaluate pair potentials with the Barnes-Hut
+     * approximation: a node seen from a point at distance d from its
+     * centroid is replaced by its total mass at the centroid if the longest
+     * side of its bounds is less than theta d and the point is outside the
+     * bounds. With theta = 0 the result is exact, and for fixed theta the
+     * cost grows as O(n log n).
+     *
+     * Points are identified by their index in the range the tree was built
+     * from.
+     */
+    template<typename K>
+    struct octree
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance and mass.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for forces.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Type of node bounds.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Type for indices of points.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        /**
+         * Maximum number of points stored in a leaf node, unless they share
+         * the same Morton code.
+         */
+        static constexpr std::size_t leaf_size = 8;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty tree.
+         */
+        octree() = default;
+
+        /**
+         * Builds a tree of points in given range, each with unit mass.
+         */
+        template<typename Iterator>
+        octree(Iterator first, Iterator last);
+
+        /**
+         * Builds a tree of points in given range. The mass of the i-th point
+         * is taken from the i-th element of the range starting at masses.
+         * Masses must not be negative.
+         */
+        template<typename Iterator, typename MassIterator>
+        octree(Iterator first, Iterator last, MassIterator masses);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of points.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if the tree has no point.
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Returns the number of nodes.
+         */
+        std::size_t node_count() const noexcept;
+
+        /**
+         * Returns the bounding box of all points. Assertion fails if the
+         * tree is empty.
+         */
+        box_type bounds() const;
+
+        /**
+         * Returns the mass-weighted centroid of all points. Assertion fails
+         * if the tree is empty.
+         */
+        point_type centroid() const;
+
+        /**
+         * Returns the sum of the masses of all points.
+         */
+        metric_type total_mass() const noexcept;
+
+        // Computation ---------------------------------------------------------
+
+        /**
+         * Computes the total potential energy of the points with opening
+         * angle theta. A pair at squared distance r2 contributes m_i m_j
+         * potential.energy(r2).
+         *
+         * The Potential type must provide energy(r2) and, for force
+         * computation, force(r2) as described for pair_engine. Long-range
+         * potentials such as inverse_distance_potential are the ones that
+         * benefit from the approximation.
+         */
+        template<typename Potential>
+        metric_type energy(Potential const& potential, metric_type theta) const;
+
+        /**
+         * Computes the total potential energy under an execution policy.
+         * Parallel policies distribute the points across threads.
+         */
+        template<typename Policy, typename Potential>
+        detail::enable_if_execution_policy<Policy, metric_type>
+        energy(Policy&& policy, Potential const& potential, metric_type theta) const;
+
+        /**
+         * Computes the force acting on each point with opening angle theta
+         * and writes them to out in the order of the range the tree was
+         * built from. Returns the total potential energy.
+         */
+        template<typename Potential, typename OutputIterator>
+        metric_type forces(Potential const& potential, metric_type theta,
+                           OutputIterator out) const;
+
+        /**
+         * Computes forces and the total potential energy under an execution
+         * policy.
+         */
+        template<typename Policy, typename Potential, typename OutputIterator>
+        detail::enable_if_execution_policy<Policy, metric_type>
+        forces(Policy&& policy, Potential const& potential, metric_type theta,
+               OutputIterator out) const;
+
+      private:
+        struct node
+        {
+            box_type bounds;
+            point_type centroid;
+            metric_type mass;
+            metric_type squared_size;
+            std::size_t begin;
+            std::size_t end;
+            std::size_t children;
+            std::size_t child_count;
+        };
+
+        // Points and nodes may be over-aligned, which std::allocator does not
+        // honour before C++17.
+        template<typename T>
+        using aligned_vector = std::vector<T, aligned_allocator<T>>;
+
+        void build(aligned_vector<point_type> const& source,
+                   std::vector<metric_type> const& masses);
+
+        void build_node(std::vector<std::uint64_t> const& codes, std::size_t self,
+                        std::size_t begin, std::size_t end);
+
+        template<bool WithForces, typename Policy, typename Potential, typename OutputIterator>
+        metric_type compute(Policy const& policy, Potential const& potential,
+                            metric_type theta, OutputIterator out) const;
+
+        template<bool WithForces, typename Potential>
+        metric_type evaluate(Potential const& potential, metric_type theta2,
+                             std::size_t target, std::vector<std::size_t>& stack,
+                             metric_type* force) const;
+
+        aligned_vector<node> nodes_;
+        std::vector<index_type> indices_;
+        aligned_vector<point_type> points_;
+        std::vector<metric_type> masses_;
+    };
+}
+
+#include "octree.ipp"
+
+#endif
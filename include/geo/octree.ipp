@@ -0,0 +1,376 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "execution.hpp"
+#include "internal/aligned_allocator.hpp"
+#include "octree.hpp"
+#include "pair_engine.hpp"
+#include "point.hpp"
+#include "space_filling_curve.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Minimum number of points worth a thread.
+        constexpr std::size_t octree_grain = std::size_t(1) << 11;
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    template<typename Iterator>
+    octree<K>::octree(Iterator first, Iterator last)
+    {
+        aligned_vector<point_type> const source(first, last);
+        std::vector<metric_type> const masses(source.size(), metric_type(1));
+        build(source, masses);
+    }
+
+    template<typename K>
+    template<typename Iterator, typename MassIterator>
+    octree<K>::octree(Iterator first, Iterator last, MassIterator masses)
+    {
+        aligned_vector<point_type> const source(first, last);
+        std::vector<metric_type> source_masses;
+        source_masses.reserve(source.size());
+        for (std::size_t i = 0; i < source.size(); ++i, ++masses) {
+            source_masses.push_back(static_cast<metric_type>(*masses));
+            GEO_ASSERT(source_masses.back() >= 0);
+        }
+        build(source, source_masses);
+    }
+
+    template<typename K>
+    void octree<K>::build(aligned_vector<point_type> const& source,
+                          std::vector<metric_type> const& masses)
+    {
+        std::size_t const count = source.size();
+        if (count == 0) {
+            return;
+        }
+
+        point_type low = source[0];
+        point_type high = low;
+        for (point_type const& p : source) {
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                low[axis] = std::min(low[axis], p[axis]);
+                high[axis] = std::max(high[axis], p[axis]);
+            }
+        }
+
+        detail::curve_grid<K> const grid {box_type {low, high}};
+        std::vector<detail::curve_entry> entries(count);
+        detail::curve_entries<K>(source.begin(), 0, count, grid,
+                                 space_filling_curve::morton, entries.data());
+        detail::radix_sort(1, entries, curve_bits(dimension) * dimension);
+
+        std::vector<std::uint64_t> codes;
+        codes.reserve(count);
+        indices_.reserve(count);
+        points_.reserve(count);
+        masses_.reserve(count);
+        for (detail::curve_entry const& entry : entries) {
+            codes.push_back(entry.code);
+            indices_.push_back(entry.index);
+            points_.push_back(source[entry.index]);
+            masses_.push_back(masses[entry.index]);
+        }
+
+        nodes_.reserve(2 * (count / leaf_size + 1));
+        nodes_.resize(1);
+        build_node(codes, 0, 0, count);
+    }
+
+    template<typename K>
+    void octree<K>::build_node(std::vector<std::uint64_t> const& codes,
+                               std::size_t self,
+                               std::size_t begin, std::size_t end)
+    {
+        point_type low = points_[begin];
+        point_type high = low;
+        metric_type mass = 0;
+        metric_type moment[dimension] {};
+
+        std::size_t children = 0;
+        std::size_t child_count = 0;
+
+        // Codes are sorted, so all codes of the range share the bits above
+        // the highest bit at which the first and the last ones differ.
+        std::uint64_t const differing = codes[begin] ^ codes[end - 1];
+
+        if (end - begin <= leaf_size || differing == 0) {
+            for (std::size_t i = begin; i < end; ++i) {
+                point_type const& p = points_[i];
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    low[axis] = std::min(low[axis], p[axis]);
+                    high[axis] = std::max(high[axis], p[axis]);
+                    moment[axis] += masses_[i] * metric_type(p[axis]);
+                }
+                mass += masses_[i];
+            }
+        } else {
+            // Split at the first level where the codes differ. Children are
+            // the runs of equal digits at that level.
+            unsigned shift = (curve_bits(dimension) - 1) * dimension;
+            while ((differing >> shift) == 0) {
+                shift -= dimension;
+            }
+
+            child_count = 1;
+            for (std::size_t i = begin + 1; i < end; ++i) {
+                if ((codes[i] >> shift) != (codes[i - 1] >> shift)) {
+                    child_count++;
+                }
+            }
+
+            children = nodes_.size();
+            nodes_.resize(children + child_count);
+
+            std::size_t child = children;
+            std::size_t child_begin = begin;
+            for (std::size_t i = begin + 1; i <= end; ++i) {
+                if (i == end || (codes[i] >> shift) != (codes[i - 1] >> shift)) {
+                    build_node(codes, child++, child_begin, i);
+                    child_begin = i;
+                }
+            }
+
+            for (child = children; child < children + child_count; ++child) {
+                node const& c = nodes_[child];
+                point_type const child_low = c.bounds.lowest_vertex();
+                point_type const child_high = c.bounds.highest_vertex();
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    low[axis] = std::min(low[axis], child_low[axis]);
+                    high[axis] = std::max(high[axis], child_high[axis]);
+                    moment[axis] += c.mass * metric_type(c.centroid[axis]);
+                }
+                mass += c.mass;
+            }
+        }
+
+        box_type const bounds {low, high};
+
+        point_type centroid = bounds.center();
+        if (mass > 0) {
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                centroid[axis] = static_cast<scalar_type>(moment[axis] / mass);
+            }
+        }
+
+        metric_type squared_size = 0;
+        for (unsigned axis = 0; axis < dimension; ++axis) {
+            metric_type const side = metric_type(high[axis]) - metric_type(low[axis]);
+            squared_size = std::max(squared_size, side * side);
+        }
+
+        nodes_[self] = node {
+            bounds, centroid, mass, squared_size, begin, end, children, child_count
+        };
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    std::size_t octree<K>::size() const noexcept
+    {
+        return points_.size();
+    }
+
+    template<typename K>
+    bool octree<K>::empty() const noexcept
+    {
+        return points_.empty();
+    }
+
+    template<typename K>
+    std::size_t octree<K>::node_count() const noexcept
+    {
+        return nodes_.size();
+    }
+
+    template<typename K>
+    auto octree<K>::bounds() const -> box_type
+    {
+        GEO_ASSERT(!empty());
+        return nodes_[0].bounds;
+    }
+
+    template<typename K>
+    auto octree<K>::centroid() const -> point_type
+    {
+        GEO_ASSERT(!empty());
+        return nodes_[0].centroid;
+    }
+
+    template<typename K>
+    auto octree<K>::total_mass() const noexcept -> metric_type
+    {
+        return empty() ? metric_type(0) : nodes_[0].mass;
+    }
+
+    // Computation -------------------------------------------------------------
+
+    template<typename K>
+    template<typename Potential>
+    auto octree<K>::energy(Potential const& potential, metric_type theta) const
+    -> metric_type
+    {
+        return energy(execution::seq, potential, theta);
+    }
+
+    template<typename K>
+    template<typename Policy, typename Potential>
+    auto octree<K>::energy(Policy&& policy, Potential const& potential,
+                           metric_type theta) const
+    -> detail::enable_if_execution_policy<Policy, metric_type>
+    {
+        return compute<false>(policy, potential, theta, detail::discard_output {});
+    }
+
+    template<typename K>
+    template<typename Potential, typename OutputIterator>
+    auto octree<K>::forces(Potential const& potential, metric_type theta,
+                           OutputIterator out) const
+    -> metric_type
+    {
+        return forces(execution::seq, potential, theta, out);
+    }
+
+    template<typename K>
+    template<typename Policy, typename Potential, typename OutputIterator>
+    auto octree<K>::forces(Policy&& policy, Potential const& potential,
+                           metric_type theta, OutputIterator out) const
+    -> detail::enable_if_execution_policy<Policy, metric_type>
+    {
+        return compute<true>(policy, potential, theta, out);
+    }
+
+    // Internals ---------------------------------------------------------------
+
+    // Every point traverses the tree on its own, so the traversals are
+    // independent and threads take contiguous runs of points in Morton
+    // order, which share most of the nodes they visit. Forces are stored
+    // point-major in the sorted order.
+
+    template<typename K>
+    template<bool WithForces, typename Policy, typename Potential, typename OutputIterator>
+    auto octree<K>::compute(Policy const& policy, Potential const& potential,
+                            metric_type theta, OutputIterator out) const
+    -> metric_type
+    {
+        std::size_t const count = size();
+        if (count == 0) {
+            return 0;
+        }
+
+        metric_type const theta2 = theta * theta;
+        unsigned const threads = detail::thread_count(policy, count, detail::octree_grain);
+
+        std::vector<metric_type> energies(threads);
+        std::vector<metric_type> forces(WithForces ? dimension * count : 0);
+
+        detail::parallel_chunks(threads, count, [&](unsigned chunk,
+                                                    std::size_t begin,
+                                                    std::size_t end) {
+            std::vector<std::size_t> stack;
+            metric_type energy = 0;
+            for (std::size_t i = begin; i < end; ++i) {
+                metric_type* const force = WithForces ? forces.data() + i * dimension : nullptr;
+                energy += masses_[i] * evaluate<WithForces>(potential, theta2, i, stack, force);
+            }
+            energies[chunk] = energy;
+        });
+
+        if (WithForces) {
+            std::vector<std::size_t> positions(count);
+            for (std::size_t i = 0; i < count; ++i) {
+                positions[indices_[i]] = i;
+            }
+
+            for (std::size_t const i : positions) {
+                vector_type force;
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    force[axis] = static_cast<scalar_type>(
+                        masses_[i] * forces[i * dimension + axis]
+                    );
+                }
+                *out++ = force;
+            }
+        }
+
+        // Every pair is seen from both of its points.
+        metric_type energy = 0;
+        for (metric_type const partial : energies) {
+            energy += partial;
+        }
+        return energy / 2;
+    }
+
+    template<typename K>
+    template<bool WithForces, typename Potential>
+    auto octree<K>::evaluate(Potential const& potential, metric_type theta2,
+                             std::size_t target, std::vector<std::size_t>& stack,
+                             metric_type* force) const
+    -> metric_type
+    {
+        point_type const& p = points_[target];
+        metric_type energy = 0;
+
+        auto const interact = [&](point_type const& q, metric_type mass) {
+            metric_type diff[dimension];
+            metric_type r2 = 0;
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                diff[axis] = metric_type(p[axis]) - metric_type(q[axis]);
+                r2 += diff[axis] * diff[axis];
+            }
+            energy += mass * potential.energy(r2);
+
+            if (WithForces) {
+                metric_type const factor = mass * potential.force(r2);
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    force[axis] += factor * diff[axis];
+                }
+            }
+        };
+
+        stack.clear();
+        stack.push_back(0);
+
+        while (!stack.empty()) {
+            node const& n = nodes_[stack.back()];
+            stack.pop_back();
+
+            if (n.child_count == 0) {
+                for (std::size_t j = n.begin; j < n.end; ++j) {
+                    if (j != target) {
+                        interact(points_[j], masses_[j]);
+                    }
+                }
+                continue;
+            }
+
+            // A node containing the target is always opened, which also
+            // keeps the target from interacting with itself.
+            if (n.squared_size < theta2 * squared_distance(p, n.centroid) &&
+                squared_distance(n.bounds, p) > 0) {
+                interact(n.centroid, n.mass);
+                continue;
+            }
+
+            for (std::size_t child = 0; child < n.child_count; ++child) {
+                stack.push_back(n.children + child);
+            }
+        }
+
+        return energy;
+    }
+}
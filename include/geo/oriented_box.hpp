@@ -0,0 +1,147 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Arbitrarily oriented box shape.
+//
+
+#ifndef GEO_ORIENTED_BOX_HPP
+#define GEO_ORIENTED_BOX_HPP
+
+#include "box.hpp"
+#include "linear_transformation.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Box whose edges point in arbitrary orthogonal directions.
+     *
+     * The inverse rotation and the extent of the bounding box are computed
+     * once at construction, so queries cost a single matrix-vector product
+     * to bring the point into the local frame of the box.
+     */
+    template<typename K>
+    struct oriented_box
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for vectors associated to the underlying Euclidean space.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Type of orientation.
+         */
+        using linear_type = linear_transformation<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates a unit box with the lowest vertex at the origin.
+         */
+        oriented_box() noexcept;
+
+        /**
+         * Creates an oriented box with the same shape as an axis-aligned box.
+         */
+        explicit
+        oriented_box(box<K> const& b) noexcept;
+
+        /**
+         * Creates a box of given center and half extents along the local
+         * axes, rotated by given orientation. The i-th column of orientation
+         * is the direction of the i-th local axis; the matrix must be
+         * orthogonal. Assertion fails if any half extent is negative.
+         */
+        oriented_box(point_type const& center,
+                     vector_type const& half_extents,
+                     linear_type const& orientation);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the center.
+         */
+        point_type center() const noexcept;
+
+        /**
+         * Returns the half extents along the local axes.
+         */
+        vector_type half_extents() const noexcept;
+
+        /**
+         * Returns the rotation from the local frame to the global frame.
+         */
+        linear_type orientation() const noexcept;
+
+        // Analytic query ------------------------------------------------------
+
+        /**
+         * Evaluates the implicit function, which is the same as
+         * oriented_distance(p).
+         */
+        metric_type potential(point_type const& p) const noexcept;
+
+        /**
+         * Evaluates the gradient of implicit function. Inside the box, this
+         * is the outward normal of the nearest face.
+         */
+        vector_type gradient(point_type const& p) const noexcept;
+
+        /**
+         * Returns the shortest distance from point to the surface.
+         *
+         * The distance is oriented so that it is negative inside the box and
+         * positive outside the box. The absolute value gives usual distance.
+         */
+        metric_type oriented_distance(point_type const& p) const noexcept;
+
+      private:
+        vector_type local_excess(point_type const& p, vector_type& local) const noexcept;
+
+        point_type center_;
+        vector_type half_extents_;
+        linear_type orientation_;
+        linear_type inverse_orientation_;
+        vector_type bounding_extent_;
+
+        template<typename L>
+        friend box<L> bounding_box(oriented_box<L> const& b) noexcept;
+    };
+
+    /**
+     * Returns the axis-aligned bounding box of oriented box.
+     */
+    template<typename K>
+    box<K> bounding_box(oriented_box<K> const& b) noexcept;
+}
+
+#include "oriented_box.ipp"
+
+#endif
@@ -0,0 +1,145 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "linear_transformation.hpp"
+#include "oriented_box.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    oriented_box<K>::oriented_box() noexcept
+        : oriented_box(box<K> {})
+    {
+    }
+
+    template<typename K>
+    oriented_box<K>::oriented_box(box<K> const& b) noexcept
+        : oriented_box(b.center(), b.diagonal_span() / scalar_type(2), linear_type {})
+    {
+    }
+
+    template<typename K>
+    oriented_box<K>::oriented_box(point_type const& center,
+                                  vector_type const& half_extents,
+                                  linear_type const& orientation)
+        : center_ {center}
+        , half_extents_ {half_extents}
+        , orientation_ {orientation}
+        , inverse_orientation_ {transpose(orientation)}
+    {
+        // The extent of the box along axis i is sum_j |R_ij| h_j.
+        for (unsigned i = 0; i < dimension; ++i) {
+            GEO_ASSERT(half_extents[i] >= 0);
+            scalar_type extent = 0;
+            for (unsigned j = 0; j < dimension; ++j) {
+                extent += std::abs(orientation.element(i, j)) * half_extents[j];
+            }
+            bounding_extent_[i] = extent;
+        }
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    auto oriented_box<K>::center() const noexcept -> point_type
+    {
+        return center_;
+    }
+
+    template<typename K>
+    auto oriented_box<K>::half_extents() const noexcept -> vector_type
+    {
+        return half_extents_;
+    }
+
+    template<typename K>
+    auto oriented_box<K>::orientation() const noexcept -> linear_type
+    {
+        return orientation_;
+    }
+
+    // Analytic query ----------------------------------------------------------
+
+    // Queries work in the local frame where the box is [-h, h]. The excess
+    // |q_i| - h_i is positive along the axes on which the point is outside.
+
+    template<typename K>
+    auto oriented_box<K>::local_excess(point_type const& p,
+                                       vector_type& local) const noexcept
+    -> vector_type
+    {
+        local = inverse_orientation_(p - center_);
+        vector_type excess;
+        for (unsigned i = 0; i < dimension; ++i) {
+            excess[i] = std::abs(local[i]) - half_extents_[i];
+        }
+        return excess;
+    }
+
+    template<typename K>
+    auto oriented_box<K>::potential(point_type const& p) const noexcept
+    -> metric_type
+    {
+        return oriented_distance(p);
+    }
+
+    template<typename K>
+    auto oriented_box<K>::oriented_distance(point_type const& p) const noexcept
+    -> metric_type
+    {
+        vector_type local;
+        vector_type const excess = local_excess(p, local);
+
+        // Outside, the norm of the positive part of the excess. Inside, the
+        // largest (negative) excess. The two terms vanish in the other case.
+        vector_type outside;
+        scalar_type depth = -std::numeric_limits<scalar_type>::infinity();
+        for (unsigned i = 0; i < dimension; ++i) {
+            outside[i] = std::max(excess[i], scalar_type(0));
+            depth = std::max(depth, excess[i]);
+        }
+        return norm(outside) + std::min(depth, scalar_type(0));
+    }
+
+    template<typename K>
+    auto oriented_box<K>::gradient(point_type const& p) const noexcept
+    -> vector_type
+    {
+        vector_type local;
+        vector_type const excess = local_excess(p, local);
+
+        unsigned nearest = 0;
+        vector_type outside;
+        for (unsigned i = 0; i < dimension; ++i) {
+            outside[i] = std::copysign(std::max(excess[i], scalar_type(0)), local[i]);
+            if (excess[i] > excess[nearest]) {
+                nearest = i;
+            }
+        }
+
+        vector_type local_gradient;
+        if (excess[nearest] > 0) {
+            local_gradient = outside / norm(outside);
+        } else {
+            local_gradient[nearest] = std::copysign(scalar_type(1), local[nearest]);
+        }
+        return orientation_(local_gradient);
+    }
+
+    // Basic algorithms --------------------------------------------------------
+
+    template<typename K>
+    box<K> bounding_box(oriented_box<K> const& b) noexcept
+    {
+        return box<K>{b.center() - b.bounding_extent_,
+                      b.center() + b.bounding_extent_};
+    }
+}
@@ -0,0 +1,162 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Arbitrarily oriented ellipsoid shape.
+//
+
+#ifndef GEO_ORIENTED_ELLIPSOID_HPP
+#define GEO_ORIENTED_ELLIPSOID_HPP
+
+#include "box.hpp"
+#include "linear_transformation.hpp"
+#include "point.hpp"
+#include "scaling_transformation.hpp"
+#include "shape_evaluation.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Ellipsoid whose semiaxes point in arbitrary orthogonal directions.
+     *
+     * The quadratic form of the implicit function and the extent of the
+     * bounding box are computed once at construction, so queries cost a
+     * single matrix-vector product.
+     */
+    template<typename K>
+    struct oriented_ellipsoid
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for vectors associated to the underlying Euclidean space.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Type of scaling transformation.
+         */
+        using scaling_type = scaling_transformation<K>;
+
+        /**
+         * Type of orientation and skin map.
+         */
+        using linear_type = linear_transformation<K>;
+
+        /**
+         * Type of fused evaluation result.
+         */
+        using evaluation_type = shape_evaluation<K, linear_type>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates a unit sphere (ellipsoid) centered at the origin.
+         */
+        oriented_ellipsoid() noexcept;
+
+        /**
+         * Creates an ellipsoid of given center and semiaxes, rotated by given
+         * orientation. The i-th column of orientation is the direction of the
+         * i-th semiaxis; the matrix must be orthogonal.
+         */
+        oriented_ellipsoid(point_type const& center,
+                           scaling_type const& semiaxes,
+                           linear_type const& orientation);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the center.
+         */
+        point_type center() const noexcept;
+
+        /**
+         * Returns the scaling transformation of semiaxes in the local frame.
+         */
+        scaling_type semiaxes() const noexcept;
+
+        /**
+         * Returns the rotation from the local frame to the global frame.
+         */
+        linear_type orientation() const noexcept;
+
+        // Analytic query ------------------------------------------------------
+
+        /**
+         * Evaluates the implicit function.
+         *
+         * The implicit function is negative inside the ellipsoid, zero at the
+         * boundary and positive outside the ellipsoid.
+         */
+        metric_type potential(point_type const& p) const noexcept;
+
+        /**
+         * Evaluates the gradient of implicit function.
+         */
+        vector_type gradient(point_type const& p) const noexcept;
+
+        /**
+         * Returns an estimate of shortest distance from point to the surface.
+         * The estimate is the same as that of ellipsoid.
+         */
+        metric_type oriented_distance(point_type const& p) const noexcept;
+
+        /**
+         * Returns a transformation that approximately maps centric position
+         * vector to surface position vector. The approximation is the same as
+         * that of ellipsoid.
+         */
+        linear_type skin_map(point_type const& p) const noexcept;
+
+        /**
+         * Evaluates potential, gradient, oriented distance and skin map at
+         * once.
+         */
+        evaluation_type evaluate(point_type const& p) const noexcept;
+
+      private:
+        point_type center_ {};
+        scaling_type semiaxes_ {};
+        linear_type orientation_ {};
+        linear_type quadratic_map_ {};
+        vector_type bounding_extent_ {};
+
+        template<typename L>
+        friend box<L> bounding_box(oriented_ellipsoid<L> const& e) noexcept;
+    };
+
+    /**
+     * Returns the axis-aligned bounding box of ellipsoid.
+     */
+    template<typename K>
+    box<K> bounding_box(oriented_ellipsoid<K> const& e) noexcept;
+}
+
+#include "oriented_ellipsoid.ipp"
+
+#endif
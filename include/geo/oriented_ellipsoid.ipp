@@ -0,0 +1,127 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include "box.hpp"
+#include "linear_transformation.hpp"
+#include "oriented_ellipsoid.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    oriented_ellipsoid<K>::oriented_ellipsoid() noexcept
+        : oriented_ellipsoid(point_type {}, scaling_type {}, linear_type {})
+    {
+    }
+
+    template<typename K>
+    oriented_ellipsoid<K>::oriented_ellipsoid(point_type const& center,
+                                              scaling_type const& semiaxes,
+                                              linear_type const& orientation)
+        : center_ {center}
+        , semiaxes_ {semiaxes}
+        , orientation_ {orientation}
+    {
+        // The implicit function is r^T Q r - 1 with Q = R S^-2 R^T, where R
+        // is the orientation and S the semiaxes.
+        linear_type const inverse_squared {scaling_type(scalar_type(1)) / (semiaxes * semiaxes)};
+        quadratic_map_ = orientation * inverse_squared * transpose(orientation);
+
+        // The extent of the ellipsoid along axis i is the norm of the i-th
+        // row of R S.
+        linear_type const stretch = orientation * linear_type {semiaxes};
+        for (unsigned i = 0; i < dimension; ++i) {
+            metric_type squared_extent = 0;
+            for (unsigned j = 0; j < dimension; ++j) {
+                squared_extent += stretch.element(i, j) * stretch.element(i, j);
+            }
+            bounding_extent_[i] = static_cast<scalar_type>(K::sqrt(squared_extent));
+        }
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::center() const noexcept -> point_type
+    {
+        return center_;
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::semiaxes() const noexcept -> scaling_type
+    {
+        return semiaxes_;
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::orientation() const noexcept -> linear_type
+    {
+        return orientation_;
+    }
+
+    // Analytic query ----------------------------------------------------------
+
+    // As in ellipsoid, the gradient is 2s where s is the image of
+    // r = p - center() by the quadratic form.
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::potential(point_type const& p) const noexcept
+    -> metric_type
+    {
+        vector_type const r = p - center_;
+        return inner_product(r, quadratic_map_(r)) - metric_type(1);
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::gradient(point_type const& p) const noexcept
+    -> vector_type
+    {
+        return scalar_type(2) * quadratic_map_(p - center_);
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::oriented_distance(point_type const& p) const noexcept
+    -> metric_type
+    {
+        vector_type const r = p - center_;
+        vector_type const s = quadratic_map_(r);
+        return (inner_product(r, s) - metric_type(1)) / (metric_type(2) * norm(s));
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::skin_map(point_type const& p) const noexcept
+    -> linear_type
+    {
+        vector_type const r = p - center_;
+        vector_type const s = quadratic_map_(r);
+        auto const pot = inner_product(r, s) - metric_type(1);
+        return (pot / (scalar_type(2) * squared_norm(s))) * quadratic_map_;
+    }
+
+    template<typename K>
+    auto oriented_ellipsoid<K>::evaluate(point_type const& p) const noexcept
+    -> evaluation_type
+    {
+        vector_type const r = p - center_;
+        vector_type const s = quadratic_map_(r);
+        metric_type const pot = inner_product(r, s) - metric_type(1);
+        metric_type const squared_half_grad = squared_norm(s);
+
+        evaluation_type result;
+        result.potential = pot;
+        result.gradient = scalar_type(2) * s;
+        result.oriented_distance = pot / (metric_type(2) * K::sqrt(squared_half_grad));
+        result.skin_map = (pot / (scalar_type(2) * squared_half_grad)) * quadratic_map_;
+        return result;
+    }
+
+    // Basic algorithms --------------------------------------------------------
+
+    template<typename K>
+    box<K> bounding_box(oriented_ellipsoid<K> const& e) noexcept
+    {
+        return box<K>{e.center() - e.bounding_extent_,
+                      e.center() + e.bounding_extent_};
+    }
+}
@@ -0,0 +1,204 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Pairwise interaction of points.
+//
+
+#ifndef GEO_PAIR_ENGINE_HPP
+#define GEO_PAIR_ENGINE_HPP
+
+#include <cstddef>
+
+#include "execution.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Lennard-Jones pair potential 4 epsilon ((sigma/r)^12 - (sigma/r)^6).
+     */
+    template<typename T>
+    struct lennard_jones_potential
+    {
+        /**
+         * Depth of the potential well.
+         */
+        T epsilon = 1;
+
+        /**
+         * Distance at which the potential is zero.
+         */
+        T sigma = 1;
+
+        /**
+         * Computes the potential energy of a pair at squared distance r2.
+         */
+        T energy(T r2) const noexcept;
+
+        /**
+         * Computes -U'(r)/r of a pair at squared distance r2. Multiplying
+         * this by the displacement from the partner gives the force.
+         */
+        T force(T r2) const noexcept;
+    };
+
+    /**
+     * Softened inverse distance potential strength / sqrt(r^2 + softening^2).
+     *
+     * A positive strength gives Coulomb repulsion and a negative one gives
+     * gravitational attraction. The softening length removes the
+     * singularity at r = 0.
+     */
+    template<typename T>
+    struct inverse_distance_potential
+    {
+        /**
+         * Energy of a pair at unit distance without softening.
+         */
+        T strength = 1;
+
+        /**
+         * Softening length.
+         */
+        T softening = 0;
+
+        /**
+         * Computes the potential energy of a pair at squared distance r2.
+         */
+        T energy(T r2) const noexcept;
+
+        /**
+         * Computes -U'(r)/r of a pair at squared distance r2.
+         */
+        T force(T r2) const noexcept;
+    };
+
+    /**
+     * Computes the total potential energy and forces of points interacting
+     * through a pair potential.
+     *
+     * The Potential type must provide energy(r2) and, for force computation,
+     * force(r2) member functions taking the squared distance of a pair. See
+     * lennard_jones_potential for the meaning of these functions.
+     *
+     * Each unordered pair is evaluated once and its force is applied to both
+     * points. Points are copied to axis-major arrays and processed in square
+     * tiles of tile_size points, so that the two streams of points touched
+     * by the inner loop stay in the L1 cache. Parallel policies distribute
+     * rows of tiles across threads; forces are then accumulated to per-thread
+     * buffers and summed at the end.
+     */
+    template<typename K, typename Potential>
+    struct pair_engine
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Alias to the template parameter Potential.
+         */
+        using potential_type = Potential;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for forces.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        /**
+         * Number of points in a tile.
+         */
+        static constexpr std::size_t tile_size = 256;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an engine with default constructed potential.
+         */
+        pair_engine() = default;
+
+        /**
+         * Creates an engine with given potential.
+         */
+        explicit
+        pair_engine(Potential const& potential);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the potential.
+         */
+        Potential const& potential() const noexcept;
+
+        // Computation ---------------------------------------------------------
+
+        /**
+         * Computes the total potential energy of points in given range.
+         */
+        template<typename Iterator>
+        metric_type energy(Iterator first, Iterator last) const;
+
+        /**
+         * Computes the total potential energy of points in given range under
+         * an execution policy.
+         */
+        template<typename Policy, typename Iterator>
+        detail::enable_if_execution_policy<Policy, metric_type>
+        energy(Policy&& policy, Iterator first, Iterator last) const;
+
+        /**
+         * Computes the force acting on each point in given range and writes
+         * them to out in the order of the points. Returns the total potential
+         * energy.
+         */
+        template<typename Iterator, typename OutputIterator>
+        metric_type forces(Iterator first, Iterator last, OutputIterator out) const;
+
+        /**
+         * Computes forces and the total potential energy under an execution
+         * policy.
+         */
+        template<typename Policy, typename Iterator, typename OutputIterator>
+        detail::enable_if_execution_policy<Policy, metric_type>
+        forces(Policy&& policy, Iterator first, Iterator last, OutputIterator out) const;
+
+      private:
+        template<bool WithForces, typename Policy, typename Iterator, typename OutputIterator>
+        metric_type compute(Policy const& policy, Iterator first, Iterator last,
+                            OutputIterator out) const;
+
+        template<bool WithForces>
+        metric_type compute_tile(scalar_type const* coords, std::size_t count,
+                                 std::size_t row, std::size_t col,
+                                 scalar_type* forces) const noexcept;
+
+        Potential potential_;
+    };
+}
+
+#include "pair_engine.ipp"
+
+#endif
@@ -0,0 +1,267 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#include "execution.hpp"
+#include "pair_engine.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    // lennard_jones_potential -------------------------------------------------
+
+    template<typename T>
+    T lennard_jones_potential<T>::energy(T r2) const noexcept
+    {
+        T const u2 = sigma * sigma / r2;
+        T const u6 = u2 * u2 * u2;
+        return 4 * epsilon * (u6 - 1) * u6;
+    }
+
+    template<typename T>
+    T lennard_jones_potential<T>::force(T r2) const noexcept
+    {
+        T const u2 = sigma * sigma / r2;
+        T const u6 = u2 * u2 * u2;
+        return 24 * epsilon * (2 * u6 - 1) * u6 / r2;
+    }
+
+    // inverse_distance_potential ----------------------------------------------
+
+    template<typename T>
+    T inverse_distance_potential<T>::energy(T r2) const noexcept
+    {
+        return strength / std::sqrt(r2 + softening * softening);
+    }
+
+    template<typename T>
+    T inverse_distance_potential<T>::force(T r2) const noexcept
+    {
+        T const s2 = r2 + softening * softening;
+        return strength / (s2 * std::sqrt(s2));
+    }
+
+    namespace detail
+    {
+        // Minimum number of pairs worth a thread.
+        constexpr std::size_t pair_engine_grain = std::size_t(1) << 20;
+
+        // Output iterator discarding everything, used when forces are not
+        // requested.
+        struct discard_output
+        {
+            struct proxy
+            {
+                template<typename T>
+                void operator=(T const&) const noexcept
+                {
+                }
+            };
+
+            proxy operator*() const noexcept
+            {
+                return {};
+            }
+
+            discard_output& operator++() noexcept
+            {
+                return *this;
+            }
+
+            discard_output operator++(int) noexcept
+            {
+                return *this;
+            }
+        };
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename K, typename Potential>
+    pair_engine<K, Potential>::pair_engine(Potential const& potential)
+        : potential_ {potential}
+    {
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K, typename Potential>
+    Potential const& pair_engine<K, Potential>::potential() const noexcept
+    {
+        return potential_;
+    }
+
+    // Computation -------------------------------------------------------------
+
+    template<typename K, typename Potential>
+    template<typename Iterator>
+    auto pair_engine<K, Potential>::energy(Iterator first, Iterator last) const
+    -> metric_type
+    {
+        return energy(execution::seq, first, last);
+    }
+
+    template<typename K, typename Potential>
+    template<typename Policy, typename Iterator>
+    auto pair_engine<K, Potential>::energy(Policy&& policy,
+                                           Iterator first, Iterator last) const
+    -> detail::enable_if_execution_policy<Policy, metric_type>
+    {
+        return compute<false>(policy, first, last, detail::discard_output {});
+    }
+
+    template<typename K, typename Potential>
+    template<typename Iterator, typename OutputIterator>
+    auto pair_engine<K, Potential>::forces(Iterator first, Iterator last,
+                                           OutputIterator out) const
+    -> metric_type
+    {
+        return forces(execution::seq, first, last, out);
+    }
+
+    template<typename K, typename Potential>
+    template<typename Policy, typename Iterator, typename OutputIterator>
+    auto pair_engine<K, Potential>::forces(Policy&& policy,
+                                           Iterator first, Iterator last,
+                                           OutputIterator out) const
+    -> detail::enable_if_execution_policy<Policy, metric_type>
+    {
+        return compute<true>(policy, first, last, out);
+    }
+
+    // Internals ---------------------------------------------------------------
+
+    // Coordinates and forces are stored axis-major: the value for axis a of
+    // point i is at a * count + i.
+
+    template<typename K, typename Potential>
+    template<bool WithForces, typename Policy, typename Iterator, typename OutputIterator>
+    auto pair_engine<K, Potential>::compute(Policy const& policy,
+                                            Iterator first, Iterator last,
+                                            OutputIterator out) const
+    -> metric_type
+    {
+        std::vector<scalar_type> coords;
+        for (; first != last; ++first) {
+            point_type const p = *first;
+            coords.insert(coords.end(), p.begin(), p.end());
+        }
+        std::size_t const count = coords.size() / dimension;
+
+        // Transpose in place through a copy to the axis-major layout.
+        {
+            std::vector<scalar_type> const interleaved = coords;
+            for (std::size_t i = 0; i < count; ++i) {
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    coords[axis * count + i] = interleaved[i * dimension + axis];
+                }
+            }
+        }
+
+        std::size_t const tiles = (count + tile_size - 1) / tile_size;
+        std::size_t const pairs = count * (count - std::min(count, std::size_t(1))) / 2;
+        unsigned const threads = detail::thread_count(policy, pairs, detail::pair_engine_grain);
+
+        std::vector<metric_type> energies(threads);
+        std::vector<std::vector<scalar_type>> forces(WithForces ? threads : 0);
+        std::atomic<std::size_t> next_row {0};
+
+        // Rows of tiles get shorter toward the end, so they are handed out
+        // dynamically from the longest.
+        detail::parallel_chunks(threads, threads, [&](unsigned chunk,
+                                                      std::size_t,
+                                                      std::size_t) {
+            scalar_type* force_buffer = nullptr;
+            if (WithForces) {
+                forces[chunk].assign(dimension * count, scalar_type(0));
+                force_buffer = forces[chunk].data();
+            }
+
+            metric_type energy = 0;
+            for (std::size_t row; (row = next_row++) < tiles; ) {
+                for (std::size_t col = row; col < tiles; ++col) {
+                    energy += compute_tile<WithForces>(
+                        coords.data(), count, row, col, force_buffer
+                    );
+                }
+            }
+            energies[chunk] = energy;
+        });
+
+        if (WithForces) {
+            for (std::size_t i = 0; i < count; ++i) {
+                vector_type force;
+                for (std::vector<scalar_type> const& buffer : forces) {
+                    for (unsigned axis = 0; axis < dimension; ++axis) {
+                        force[axis] += buffer[axis * count + i];
+                    }
+                }
+                *out++ = force;
+            }
+        }
+
+        metric_type energy = 0;
+        for (metric_type const partial : energies) {
+            energy += partial;
+        }
+        return energy;
+    }
+
+    template<typename K, typename Potential>
+    template<bool WithForces>
+    auto pair_engine<K, Potential>::compute_tile(scalar_type const* coords,
+                                                 std::size_t count,
+                                                 std::size_t row,
+                                                 std::size_t col,
+                                                 scalar_type* forces) const noexcept
+    -> metric_type
+    {
+        std::size_t const i_begin = row * tile_size;
+        std::size_t const i_end = std::min(i_begin + tile_size, count);
+        std::size_t const j_end = std::min(col * tile_size + tile_size, count);
+
+        metric_type energy = 0;
+
+        for (std::size_t i = i_begin; i < i_end; ++i) {
+            scalar_type pi[dimension];
+            scalar_type fi[dimension] {};
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                pi[axis] = coords[axis * count + i];
+            }
+
+            std::size_t const j_begin = row == col ? i + 1 : col * tile_size;
+            for (std::size_t j = j_begin; j < j_end; ++j) {
+                scalar_type diff[dimension];
+                metric_type r2 = 0;
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    diff[axis] = pi[axis] - coords[axis * count + j];
+                    r2 += diff[axis] * diff[axis];
+                }
+                energy += potential_.energy(r2);
+
+                if (WithForces) {
+                    auto const factor = potential_.force(r2);
+                    for (unsigned axis = 0; axis < dimension; ++axis) {
+                        scalar_type const f = factor * diff[axis];
+                        fi[axis] += f;
+                        forces[axis * count + j] -= f;
+                    }
+                }
+            }
+
+            if (WithForces) {
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    forces[axis * count + i] += fi[axis];
+                }
+            }
+        }
+
+        return energy;
+    }
+}
@@ -0,0 +1,154 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Periodic boundary conditions.
+//
+
+#ifndef GEO_PERIODIC_BOX_HPP
+#define GEO_PERIODIC_BOX_HPP
+
+#include "box.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Metric of a box domain with periodic boundaries.
+     *
+     * Displacements and distances are measured by the minimum image
+     * convention: the displacement from q to p is the shortest one among
+     * all periodic images of p. The reduction is branch-free so that it
+     * can be used in vectorized pair loops.
+     *
+     * An axis with zero period is treated as non-periodic.
+     */
+    template<typename K>
+    struct periodic_box
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for vectors associated to the underlying Euclidean space.
+         */
+        using vector_type = vector<K>;
+
+        /**
+         * Type of the domain.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates a unit box periodic along all axes.
+         */
+        periodic_box() noexcept;
+
+        /**
+         * Creates a box domain periodic along all axes. Assertion fails if
+         * the domain has zero extent along some axis.
+         */
+        explicit
+        periodic_box(box_type const& domain) noexcept;
+
+        /**
+         * Creates a box domain periodic along the axes where the element of
+         * periodic is true. The domain may have zero extent along the other
+         * axes, as with a slab. Assertion fails if it has zero extent along
+         * a periodic axis.
+         */
+        periodic_box(box_type const& domain, bool const (&periodic)[K::dimension]) noexcept;
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the domain.
+         */
+        box_type domain() const noexcept;
+
+        /**
+         * Returns the period along each axis. Non-periodic axes have zero
+         * period.
+         */
+        vector_type period() const noexcept;
+
+        // Metric --------------------------------------------------------------
+
+        /**
+         * Reduces a displacement vector to its minimum image.
+         */
+        vector_type minimum_image(vector_type const& v) const noexcept;
+
+        /**
+         * Computes the minimum image displacement vector from q to p.
+         */
+        vector_type displacement(point_type const& p, point_type const& q) const noexcept;
+
+        /**
+         * Computes the squared minimum image distance between points.
+         */
+        metric_type squared_distance(point_type const& p, point_type const& q) const noexcept;
+
+        /**
+         * Computes the minimum image distance between points.
+         */
+        metric_type distance(point_type const& p, point_type const& q) const noexcept;
+
+        /**
+         * Returns the periodic image of p that lies in the domain.
+         */
+        point_type wrap(point_type const& p) const noexcept;
+
+      private:
+        box_type domain_;
+        vector_type period_;
+        vector_type inverse_period_;
+    };
+
+    /**
+     * Computes the squared minimum image distance between points. Same as
+     * metric.squared_distance(p, q).
+     */
+    template<typename K>
+    typename K::metric squared_distance(point<K> const& p,
+                                        point<K> const& q,
+                                        periodic_box<K> const& metric) noexcept;
+
+    /**
+     * Computes the minimum image distance between points. Same as
+     * metric.distance(p, q).
+     */
+    template<typename K>
+    typename K::metric distance(point<K> const& p,
+                                point<K> const& q,
+                                periodic_box<K> const& metric) noexcept;
+}
+
+#include "periodic_box.ipp"
+
+#endif
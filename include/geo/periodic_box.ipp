@@ -0,0 +1,153 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "periodic_box.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Rounds to the nearest integer, ties away from zero, like std::round
+        // which is a library call without SSE4.1. Adding the largest value
+        // below one half and truncating compiles to sign-mask and conversion
+        // instructions without any branch. Adding one half itself would round
+        // 0.49999999999999994 up to one. Magnitudes of at least
+        // 2^(digits - 1) are integers already and are returned as is, which
+        // also keeps the conversion defined.
+        template<typename T>
+        T round_to_nearest(T x) noexcept
+        {
+            constexpr T below_half = T(0.5) - std::numeric_limits<T>::epsilon() / 4;
+            constexpr T limit =
+                T(std::uint64_t(1) << (std::numeric_limits<T>::digits - 1));
+            if (!(std::abs(x) < limit)) {
+                return x;
+            }
+            return static_cast<T>(static_cast<long long>(x + std::copysign(below_half, x)));
+        }
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    periodic_box<K>::periodic_box() noexcept
+        : periodic_box(box_type {})
+    {
+    }
+
+    template<typename K>
+    periodic_box<K>::periodic_box(box_type const& domain) noexcept
+        : domain_ {domain}
+        , period_ {domain.diagonal_span()}
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            GEO_ASSERT(period_[i] > 0);
+            inverse_period_[i] = scalar_type(1) / period_[i];
+        }
+    }
+
+    template<typename K>
+    periodic_box<K>::periodic_box(box_type const& domain,
+                                  bool const (&periodic)[K::dimension]) noexcept
+        : domain_ {domain}
+    {
+        vector_type const span = domain.diagonal_span();
+        for (unsigned i = 0; i < dimension; ++i) {
+            if (periodic[i]) {
+                GEO_ASSERT(span[i] > 0);
+                period_[i] = span[i];
+                inverse_period_[i] = scalar_type(1) / span[i];
+            } else {
+                period_[i] = 0;
+                inverse_period_[i] = 0;
+            }
+        }
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    auto periodic_box<K>::domain() const noexcept -> box_type
+    {
+        return domain_;
+    }
+
+    template<typename K>
+    auto periodic_box<K>::period() const noexcept -> vector_type
+    {
+        return period_;
+    }
+
+    // Metric ------------------------------------------------------------------
+
+    template<typename K>
+    auto periodic_box<K>::minimum_image(vector_type const& v) const noexcept
+    -> vector_type
+    {
+        // Zero inverse period gives zero shift on non-periodic axes.
+        vector_type image = v;
+        for (unsigned i = 0; i < dimension; ++i) {
+            image[i] -= period_[i] * detail::round_to_nearest(v[i] * inverse_period_[i]);
+        }
+        return image;
+    }
+
+    template<typename K>
+    auto periodic_box<K>::displacement(point_type const& p,
+                                       point_type const& q) const noexcept
+    -> vector_type
+    {
+        return minimum_image(p - q);
+    }
+
+    template<typename K>
+    auto periodic_box<K>::squared_distance(point_type const& p,
+                                           point_type const& q) const noexcept
+    -> metric_type
+    {
+        return squared_norm(displacement(p, q));
+    }
+
+    template<typename K>
+    auto periodic_box<K>::distance(point_type const& p,
+                                   point_type const& q) const noexcept
+    -> metric_type
+    {
+        return K::sqrt(squared_distance(p, q));
+    }
+
+    template<typename K>
+    auto periodic_box<K>::wrap(point_type const& p) const noexcept -> point_type
+    {
+        point_type const low = domain_.lowest_vertex();
+        point_type image = p;
+        for (unsigned i = 0; i < dimension; ++i) {
+            image[i] -= period_[i] * std::floor((p[i] - low[i]) * inverse_period_[i]);
+        }
+        return image;
+    }
+
+    template<typename K>
+    typename K::metric squared_distance(point<K> const& p,
+                                        point<K> const& q,
+                                        periodic_box<K> const& metric) noexcept
+    {
+        return metric.squared_distance(p, q);
+    }
+
+    template<typename K>
+    typename K::metric distance(point<K> const& p,
+                                point<K> const& q,
+                                periodic_box<K> const& metric) noexcept
+    {
+        return metric.distance(p, q);
+    }
+}
@@ -34,6 +34,12 @@ namespace geo
          */
         using scalar_type = typename K::scalar;
 
+        /**
+         * Type for distance and inner products, which may be wider than
+         * scalar_type.
+         */
+        using metric_type = typename K::metric;
+
         /**
          * Type for vectors associated to the underlying Euclidean space.
          */
@@ -80,6 +86,24 @@ namespace geo
          */
         constexpr
         point& operator-=(vector_type const& v) noexcept;
+
+#ifdef GEO_EXPRESSION_TEMPLATES
+        /**
+         * Translates point by a vector expression, evaluated in the same
+         * pass.
+         */
+        template<typename E>
+        constexpr
+        point& operator+=(linear_expression<E, vector_type, K> const& v) noexcept;
+
+        /**
+         * Translates point by a vector expression, evaluated in the same
+         * pass.
+         */
+        template<typename E>
+        constexpr
+        point& operator-=(linear_expression<E, vector_type, K> const& v) noexcept;
+#endif
     };
 
     /**
@@ -96,6 +120,24 @@ namespace geo
     constexpr
     point<K> operator-(point<K> const& p, vector<K> const& v) noexcept;
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+    /**
+     * Translates point by a vector expression.
+     */
+    template<typename K, typename E>
+    constexpr
+    point<K> operator+(point<K> const& p,
+                       linear_expression<E, vector<K>, K> const& v) noexcept;
+
+    /**
+     * Translates point by a vector expression.
+     */
+    template<typename K, typename E>
+    constexpr
+    point<K> operator-(point<K> const& p,
+                       linear_expression<E, vector<K>, K> const& v) noexcept;
+#endif
+
     /**
      * Computes displacement vector from one point to another.
      */
@@ -118,12 +160,13 @@ namespace geo
      *
      * This function computes the squared root of squared_distance(p, q) using
      * K::sqrt() function. So compilation would fail if the kernel does not
-     * provide sqrt() function.
+     * provide sqrt() function. The result has the type returned by
+     * K::sqrt(), which is usually K::metric.
      */
     template<typename K>
     constexpr
-    typename K::metric distance(point<K> const& p,
-                                point<K> const& q) noexcept;
+    detail::length_type_of<K> distance(point<K> const& p,
+                                       point<K> const& q) noexcept;
 }
 
 #include "point.ipp"
@@ -21,8 +21,10 @@ namespace geo
     constexpr
     point<K>& point<K>::operator+=(vector_type const& other) noexcept
     {
-        for (unsigned i = 0; i < dimension; ++i) {
-            (*this)[i] += other[i];
+        scalar_type* const lanes = this->data();
+        scalar_type const* const other_lanes = other.data();
+        for (unsigned i = 0; i < mixin::storage_dimension; ++i) {
+            lanes[i] += other_lanes[i];
         }
         return *this;
     }
@@ -31,12 +33,64 @@ namespace geo
     constexpr
     point<K>& point<K>::operator-=(vector_type const& other) noexcept
     {
-        for (unsigned i = 0; i < dimension; ++i) {
-            (*this)[i] -= other[i];
+        scalar_type* const lanes = this->data();
+        scalar_type const* const other_lanes = other.data();
+        for (unsigned i = 0; i < mixin::storage_dimension; ++i) {
+            lanes[i] -= other_lanes[i];
         }
         return *this;
     }
 
+#ifdef GEO_EXPRESSION_TEMPLATES
+    template<typename K>
+    template<typename E>
+    constexpr
+    point<K>& point<K>::operator+=(linear_expression<E, vector_type, K> const& other) noexcept
+    {
+        constexpr unsigned lanes_count =
+            E::padding_safe ? mixin::storage_dimension : dimension;
+
+        scalar_type* const lanes = this->data();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] += e.lane(i);
+        }
+        return *this;
+    }
+
+    template<typename K>
+    template<typename E>
+    constexpr
+    point<K>& point<K>::operator-=(linear_expression<E, vector_type, K> const& other) noexcept
+    {
+        constexpr unsigned lanes_count =
+            E::padding_safe ? mixin::storage_dimension : dimension;
+
+        scalar_type* const lanes = this->data();
+        E const& e = other.expression();
+        for (unsigned i = 0; i < lanes_count; ++i) {
+            lanes[i] -= e.lane(i);
+        }
+        return *this;
+    }
+
+    template<typename K, typename E>
+    constexpr
+    point<K> operator+(point<K> const& p,
+                       linear_expression<E, vector<K>, K> const& v) noexcept
+    {
+        return point<K>(p) += v;
+    }
+
+    template<typename K, typename E>
+    constexpr
+    point<K> operator-(point<K> const& p,
+                       linear_expression<E, vector<K>, K> const& v) noexcept
+    {
+        return point<K>(p) -= v;
+    }
+#endif
+
     template<typename K>
     constexpr
     point<K> operator+(point<K> const& p, vector<K> const& v) noexcept
@@ -58,8 +112,8 @@ namespace geo
         vector<K> to_vector(point<K> const& p) noexcept
         {
             vector<K> v;
-            for (unsigned i = 0; i < K::dimension; ++i) {
-                v[i] = p[i];
+            for (unsigned i = 0; i < point<K>::mixin::storage_dimension; ++i) {
+                v.data()[i] = p.data()[i];
             }
             return v;
         }
@@ -79,13 +133,24 @@ namespace geo
     typename K::metric squared_distance(point<K> const& p,
                                         point<K> const& q) noexcept
     {
-        return squared_norm(p - q);
+        // Differences are taken in the metric type so that no precision is
+        // lost before squaring when the scalar type is narrower.
+        using metric_type = typename K::metric;
+
+        typename K::scalar const* const p_lanes = p.data();
+        typename K::scalar const* const q_lanes = q.data();
+        metric_type sum = 0;
+        for (unsigned i = 0; i < point<K>::mixin::storage_dimension; ++i) {
+            metric_type const diff = metric_type(p_lanes[i]) - metric_type(q_lanes[i]);
+            sum += diff * diff;
+        }
+        return sum;
     }
 
     template<typename K>
     constexpr
-    typename K::metric distance(point<K> const& p,
-                                point<K> const& q) noexcept
+    detail::length_type_of<K> distance(point<K> const& p,
+                                       point<K> const& q) noexcept
     {
         return K::sqrt(squared_distance(p, q));
     }
@@ -0,0 +1,366 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Structure-of-arrays container of points.
+//
+
+#ifndef GEO_POINT_SOA_HPP
+#define GEO_POINT_SOA_HPP
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "internal/aligned_allocator.hpp"
+#include "point.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    template<typename K>
+    struct point_soa;
+
+    /**
+     * Proxy reference to a point stored in point_soa.
+     *
+     * The proxy converts to point<K> and can be assigned a point<K>, so it
+     * behaves like point<K>& in most expressions. Individual coordinates can
+     * be accessed by mutable reference via indexing operator.
+     */
+    template<typename K>
+    struct point_soa_reference
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type of referenced point.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        /**
+         * Creates a reference to the index-th point of the container.
+         */
+        point_soa_reference(point_soa<K>& container, std::size_t index) noexcept;
+
+        /**
+         * Gathers the coordinates of the referenced point.
+         */
+        point_type load() const noexcept;
+
+        /**
+         * Same as load().
+         */
+        operator point_type() const noexcept;
+
+        /**
+         * Scatters coordinates to the referenced point.
+         */
+        point_soa_reference const& operator=(point_type const& p) const noexcept;
+
+        /**
+         * Copies the point referenced by other into the referenced point.
+         */
+        point_soa_reference const& operator=(point_soa_reference const& other) const noexcept;
+
+        /**
+         * Translates the referenced point by a vector.
+         */
+        point_soa_reference const& operator+=(vector<K> const& v) const noexcept;
+
+        /**
+         * Translates the referenced point by a vector.
+         */
+        point_soa_reference const& operator-=(vector<K> const& v) const noexcept;
+
+        /**
+         * Coordinate access by indexing.
+         */
+        scalar_type& operator[](unsigned axis) const;
+
+      private:
+        point_soa<K>* container_;
+        std::size_t index_;
+    };
+
+    /**
+     * Swaps the points referenced by proxies.
+     */
+    template<typename K>
+    void swap(point_soa_reference<K> a, point_soa_reference<K> b) noexcept;
+
+    namespace detail
+    {
+        /*
+         * Random access iterator over point_soa. Dereferencing yields Ref,
+         * which is either point_soa_reference<K> or point<K> (by value).
+         */
+        template<typename Container, typename Ref>
+        struct point_soa_iterator
+        {
+            using iterator_category = std::random_access_iterator_tag;
+            using value_type = typename Container::value_type;
+            using difference_type = std::ptrdiff_t;
+            using reference = Ref;
+            using pointer = void;
+
+            point_soa_iterator() noexcept = default;
+
+            point_soa_iterator(Container* container, std::size_t index) noexcept;
+
+            template<typename C, typename R>
+            point_soa_iterator(point_soa_iterator<C, R> const& other) noexcept;
+
+            reference operator*() const;
+            reference operator[](difference_type n) const;
+
+            point_soa_iterator& operator++() noexcept;
+            point_soa_iterator& operator--() noexcept;
+            point_soa_iterator operator++(int) noexcept;
+            point_soa_iterator operator--(int) noexcept;
+            point_soa_iterator& operator+=(difference_type n) noexcept;
+            point_soa_iterator& operator-=(difference_type n) noexcept;
+
+            Container* container_ = nullptr;
+            std::size_t index_ = 0;
+        };
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator+(point_soa_iterator<C, R> it,
+                                           std::ptrdiff_t n) noexcept;
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator+(std::ptrdiff_t n,
+                                           point_soa_iterator<C, R> it) noexcept;
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator-(point_soa_iterator<C, R> it,
+                                           std::ptrdiff_t n) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        std::ptrdiff_t operator-(point_soa_iterator<C1, R1> const& a,
+                                 point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator==(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator!=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator<(point_soa_iterator<C1, R1> const& a,
+                       point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator>(point_soa_iterator<C1, R1> const& a,
+                       point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator<=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept;
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator>=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept;
+    }
+
+    /**
+     * Sequence of points stored as a structure of arrays.
+     *
+     * Each coordinate axis is kept in its own contiguous array aligned to
+     * simd_alignment bytes, so loops over a single axis can be vectorized.
+     * The arrays can be accessed directly via axis() member function.
+     *
+     * Element access through a mutable container yields point_soa_reference
+     * proxy. Element access through a const container yields point<K> by
+     * value, so const ranges can be passed as-is to generic algorithms like
+     * centroid().
+     */
+    template<typename K>
+    struct point_soa
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type of stored points.
+         */
+        using point_type = point<K>;
+
+        using value_type = point_type;
+        using reference = point_soa_reference<K>;
+        using const_reference = point_type;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using iterator = detail::point_soa_iterator<point_soa, reference>;
+        using const_iterator = detail::point_soa_iterator<point_soa const, const_reference>;
+
+        /**
+         * Contiguous array type used for each axis.
+         */
+        using axis_array = std::vector<scalar_type, aligned_allocator<scalar_type>>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty container.
+         */
+        point_soa() = default;
+
+        /**
+         * Creates a container of n points at the origin.
+         */
+        explicit
+        point_soa(size_type n);
+
+        /**
+         * Creates a container holding copies of points in given range.
+         */
+        template<typename Iterator>
+        point_soa(Iterator first, Iterator last);
+
+        // Capacity ------------------------------------------------------------
+
+        /**
+         * Returns the number of points.
+         */
+        size_type size() const noexcept;
+
+        /**
+         * Returns true if the container has no point.
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Reserves storage for n points in each axis array.
+         */
+        void reserve(size_type n);
+
+        /**
+         * Resizes the container. New points are placed at the origin.
+         */
+        void resize(size_type n);
+
+        /**
+         * Removes all points.
+         */
+        void clear() noexcept;
+
+        // Modifiers -----------------------------------------------------------
+
+        /**
+         * Appends a point.
+         */
+        void push_back(point_type const& p);
+
+        // Element access ------------------------------------------------------
+
+        /**
+         * Accesses the point at given index.
+         */
+        reference operator[](size_type index);
+
+        const_reference operator[](size_type index) const;
+
+        /**
+         * Returns a pointer to the contiguous coordinate array of given axis.
+         *
+         * The pointer is aligned to simd_alignment bytes and is valid until
+         * the container is resized.
+         */
+        scalar_type* axis(unsigned axis) noexcept;
+
+        scalar_type const* axis(unsigned axis) const noexcept;
+
+        /**
+         * Range access.
+         */
+        iterator begin() noexcept;
+        iterator end() noexcept;
+        const_iterator begin() const noexcept;
+        const_iterator end() const noexcept;
+        const_iterator cbegin() const noexcept;
+        const_iterator cend() const noexcept;
+
+      private:
+        axis_array axes_[dimension];
+    };
+
+    // Basic operations --------------------------------------------------------
+
+    /**
+     * Computes displacement vector between referenced points.
+     */
+    template<typename K>
+    vector<K> operator-(point_soa_reference<K> const& p,
+                        point_soa_reference<K> const& q) noexcept;
+
+    template<typename K>
+    vector<K> operator-(point_soa_reference<K> const& p,
+                        point<K> const& q) noexcept;
+
+    template<typename K>
+    vector<K> operator-(point<K> const& p,
+                        point_soa_reference<K> const& q) noexcept;
+
+    /**
+     * Computes the squared Euclidean distance between referenced points.
+     */
+    template<typename K>
+    typename K::metric squared_distance(point_soa_reference<K> const& p,
+                                        point_soa_reference<K> const& q) noexcept;
+
+    template<typename K>
+    typename K::metric squared_distance(point_soa_reference<K> const& p,
+                                        point<K> const& q) noexcept;
+
+    template<typename K>
+    typename K::metric squared_distance(point<K> const& p,
+                                        point_soa_reference<K> const& q) noexcept;
+
+    /**
+     * Computes the Euclidean distance between referenced points.
+     */
+    template<typename K>
+    detail::length_type_of<K> distance(point_soa_reference<K> const& p,
+                                       point_soa_reference<K> const& q) noexcept;
+
+    template<typename K>
+    detail::length_type_of<K> distance(point_soa_reference<K> const& p,
+                                       point<K> const& q) noexcept;
+
+    template<typename K>
+    detail::length_type_of<K> distance(point<K> const& p,
+                                       point_soa_reference<K> const& q) noexcept;
+}
+
+#include "point_soa.ipp"
+
+#endif
@@ -0,0 +1,453 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "assert.hpp"
+#include "point.hpp"
+#include "point_soa.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    // Proxy reference ---------------------------------------------------------
+
+    template<typename K>
+    point_soa_reference<K>::point_soa_reference(point_soa<K>& container,
+                                                std::size_t index) noexcept
+        : container_ {&container}
+        , index_ {index}
+    {
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::load() const noexcept -> point_type
+    {
+        point_type p;
+        for (unsigned i = 0; i < dimension; ++i) {
+            p[i] = container_->axis(i)[index_];
+        }
+        return p;
+    }
+
+    template<typename K>
+    point_soa_reference<K>::operator point_type() const noexcept
+    {
+        return load();
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::operator=(point_type const& p) const noexcept
+    -> point_soa_reference const&
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            container_->axis(i)[index_] = p[i];
+        }
+        return *this;
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::operator=(point_soa_reference const& other) const noexcept
+    -> point_soa_reference const&
+    {
+        return *this = other.load();
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::operator+=(vector<K> const& v) const noexcept
+    -> point_soa_reference const&
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            container_->axis(i)[index_] += v[i];
+        }
+        return *this;
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::operator-=(vector<K> const& v) const noexcept
+    -> point_soa_reference const&
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            container_->axis(i)[index_] -= v[i];
+        }
+        return *this;
+    }
+
+    template<typename K>
+    auto point_soa_reference<K>::operator[](unsigned axis) const -> scalar_type&
+    {
+        GEO_EXTRA_ASSERT(axis < dimension);
+        return container_->axis(axis)[index_];
+    }
+
+    template<typename K>
+    void swap(point_soa_reference<K> a, point_soa_reference<K> b) noexcept
+    {
+        point<K> const tmp = a;
+        a = b;
+        b = tmp;
+    }
+
+    // Iterator ----------------------------------------------------------------
+
+    namespace detail
+    {
+        template<typename Container, typename Ref>
+        point_soa_iterator<Container, Ref>::point_soa_iterator(
+            Container* container, std::size_t index) noexcept
+            : container_ {container}
+            , index_ {index}
+        {
+        }
+
+        template<typename Container, typename Ref>
+        template<typename C, typename R>
+        point_soa_iterator<Container, Ref>::point_soa_iterator(
+            point_soa_iterator<C, R> const& other) noexcept
+            : container_ {other.container_}
+            , index_ {other.index_}
+        {
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator*() const -> reference
+        {
+            return (*container_)[index_];
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator[](difference_type n) const
+        -> reference
+        {
+            return (*container_)[index_ + n];
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator++() noexcept
+        -> point_soa_iterator&
+        {
+            ++index_;
+            return *this;
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator--() noexcept
+        -> point_soa_iterator&
+        {
+            --index_;
+            return *this;
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator++(int) noexcept
+        -> point_soa_iterator
+        {
+            point_soa_iterator const copy = *this;
+            ++index_;
+            return copy;
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator--(int) noexcept
+        -> point_soa_iterator
+        {
+            point_soa_iterator const copy = *this;
+            --index_;
+            return copy;
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator+=(difference_type n) noexcept
+        -> point_soa_iterator&
+        {
+            index_ += n;
+            return *this;
+        }
+
+        template<typename Container, typename Ref>
+        auto point_soa_iterator<Container, Ref>::operator-=(difference_type n) noexcept
+        -> point_soa_iterator&
+        {
+            index_ -= n;
+            return *this;
+        }
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator+(point_soa_iterator<C, R> it,
+                                           std::ptrdiff_t n) noexcept
+        {
+            return it += n;
+        }
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator+(std::ptrdiff_t n,
+                                           point_soa_iterator<C, R> it) noexcept
+        {
+            return it += n;
+        }
+
+        template<typename C, typename R>
+        point_soa_iterator<C, R> operator-(point_soa_iterator<C, R> it,
+                                           std::ptrdiff_t n) noexcept
+        {
+            return it -= n;
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        std::ptrdiff_t operator-(point_soa_iterator<C1, R1> const& a,
+                                 point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return static_cast<std::ptrdiff_t>(a.index_) -
+                   static_cast<std::ptrdiff_t>(b.index_);
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator==(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            GEO_EXTRA_ASSERT(a.container_ == b.container_);
+            return a.index_ == b.index_;
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator!=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return !(a == b);
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator<(point_soa_iterator<C1, R1> const& a,
+                       point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return a.index_ < b.index_;
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator>(point_soa_iterator<C1, R1> const& a,
+                       point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return b < a;
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator<=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return !(b < a);
+        }
+
+        template<typename C1, typename R1, typename C2, typename R2>
+        bool operator>=(point_soa_iterator<C1, R1> const& a,
+                        point_soa_iterator<C2, R2> const& b) noexcept
+        {
+            return !(a < b);
+        }
+    }
+
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    point_soa<K>::point_soa(size_type n)
+    {
+        resize(n);
+    }
+
+    template<typename K>
+    template<typename Iterator>
+    point_soa<K>::point_soa(Iterator first, Iterator last)
+    {
+        using category = typename std::iterator_traits<Iterator>::iterator_category;
+        if (std::is_base_of<std::forward_iterator_tag, category>::value) {
+            reserve(static_cast<size_type>(std::distance(first, last)));
+        }
+        for (; first != last; ++first) {
+            push_back(*first);
+        }
+    }
+
+    // Capacity ----------------------------------------------------------------
+
+    template<typename K>
+    auto point_soa<K>::size() const noexcept -> size_type
+    {
+        return axes_[0].size();
+    }
+
+    template<typename K>
+    bool point_soa<K>::empty() const noexcept
+    {
+        return axes_[0].empty();
+    }
+
+    template<typename K>
+    void point_soa<K>::reserve(size_type n)
+    {
+        for (axis_array& coords : axes_) {
+            coords.reserve(n);
+        }
+    }
+
+    template<typename K>
+    void point_soa<K>::resize(size_type n)
+    {
+        for (axis_array& coords : axes_) {
+            coords.resize(n);
+        }
+    }
+
+    template<typename K>
+    void point_soa<K>::clear() noexcept
+    {
+        for (axis_array& coords : axes_) {
+            coords.clear();
+        }
+    }
+
+    // Modifiers ---------------------------------------------------------------
+
+    template<typename K>
+    void point_soa<K>::push_back(point_type const& p)
+    {
+        for (unsigned i = 0; i < dimension; ++i) {
+            axes_[i].push_back(p[i]);
+        }
+    }
+
+    // Element access ----------------------------------------------------------
+
+    template<typename K>
+    auto point_soa<K>::operator[](size_type index) -> reference
+    {
+        GEO_EXTRA_ASSERT(index < size());
+        return reference(*this, index);
+    }
+
+    template<typename K>
+    auto point_soa<K>::operator[](size_type index) const -> const_reference
+    {
+        GEO_EXTRA_ASSERT(index < size());
+        point_type p;
+        for (unsigned i = 0; i < dimension; ++i) {
+            p[i] = axes_[i][index];
+        }
+        return p;
+    }
+
+    template<typename K>
+    auto point_soa<K>::axis(unsigned axis) noexcept -> scalar_type*
+    {
+        GEO_EXTRA_ASSERT(axis < dimension);
+        return axes_[axis].data();
+    }
+
+    template<typename K>
+    auto point_soa<K>::axis(unsigned axis) const noexcept -> scalar_type const*
+    {
+        GEO_EXTRA_ASSERT(axis < dimension);
+        return axes_[axis].data();
+    }
+
+    template<typename K>
+    auto point_soa<K>::begin() noexcept -> iterator
+    {
+        return iterator(this, 0);
+    }
+
+    template<typename K>
+    auto point_soa<K>::end() noexcept -> iterator
+    {
+        return iterator(this, size());
+    }
+
+    template<typename K>
+    auto point_soa<K>::begin() const noexcept -> const_iterator
+    {
+        return const_iterator(this, 0);
+    }
+
+    template<typename K>
+    auto point_soa<K>::end() const noexcept -> const_iterator
+    {
+        return const_iterator(this, size());
+    }
+
+    template<typename K>
+    auto point_soa<K>::cbegin() const noexcept -> const_iterator
+    {
+        return begin();
+    }
+
+    template<typename K>
+    auto point_soa<K>::cend() const noexcept -> const_iterator
+    {
+        return end();
+    }
+
+    // Basic operations --------------------------------------------------------
+
+    template<typename K>
+    vector<K> operator-(point_soa_reference<K> const& p,
+                        point_soa_reference<K> const& q) noexcept
+    {
+        return p.load() - q.load();
+    }
+
+    template<typename K>
+    vector<K> operator-(point_soa_reference<K> const& p,
+                        point<K> const& q) noexcept
+    {
+        return p.load() - q;
+    }
+
+    template<typename K>
+    vector<K> operator-(point<K> const& p,
+                        point_soa_reference<K> const& q) noexcept
+    {
+        return p - q.load();
+    }
+
+    template<typename K>
+    typename K::metric squared_distance(point_soa_reference<K> const& p,
+                                        point_soa_reference<K> const& q) noexcept
+    {
+        return squared_distance(p.load(), q.load());
+    }
+
+    template<typename K>
+    typename K::metric squared_distance(point_soa_reference<K> const& p,
+                                        point<K> const& q) noexcept
+    {
+        return squared_distance(p.load(), q);
+    }
+
+    template<typename K>
+    typename K::metric squared_distance(point<K> const& p,
+                                        point_soa_reference<K> const& q) noexcept
+    {
+        return squared_distance(p, q.load());
+    }
+
+    template<typename K>
+    detail::length_type_of<K> distance(point_soa_reference<K> const& p,
+                                       point_soa_reference<K> const& q) noexcept
+    {
+        return distance(p.load(), q.load());
+    }
+
+    template<typename K>
+    detail::length_type_of<K> distance(point_soa_reference<K> const& p,
+                                       point<K> const& q) noexcept
+    {
+        return distance(p.load(), q);
+    }
+
+    template<typename K>
+    detail::length_type_of<K> distance(point<K> const& p,
+                                       point_soa_reference<K> const& q) noexcept
+    {
+        return distance(p, q.load());
+    }
+}
@@ -0,0 +1,118 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Quantization of points in a box onto an integer grid.
+//
+
+#ifndef GEO_QUANTIZER_HPP
+#define GEO_QUANTIZER_HPP
+
+#include "box.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    /**
+     * Maps points in a box domain of kernel K to the integer coordinates of
+     * kernel Q, such as integer_kernel, and back.
+     *
+     * The grid has the same spacing along all axes, so that distances on
+     * the grid are proportional to distances in the domain. The longest
+     * side of the domain is divided into 2^Q::coordinate_bits - 1 steps,
+     * which keeps squared distances between quantized points exact.
+     */
+    template<typename K, typename Q>
+    struct quantizer
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Alias to the template parameter Q.
+         */
+        using quantized_kernel = Q;
+
+        /**
+         * Type for distance measured in the domain.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the domain.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for points on the grid.
+         */
+        using quantized_point_type = point<Q>;
+
+        /**
+         * Type of the domain.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        static_assert(Q::dimension == K::dimension, "");
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates a quantizer of the unit box.
+         */
+        quantizer() noexcept;
+
+        /**
+         * Creates a quantizer of given domain.
+         */
+        explicit
+        quantizer(box_type const& domain) noexcept;
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the domain.
+         */
+        box_type domain() const noexcept;
+
+        /**
+         * Returns the grid spacing, that is, the distance in the domain
+         * corresponding to unit distance on the grid.
+         */
+        metric_type resolution() const noexcept;
+
+        /**
+         * Returns the largest grid coordinate.
+         */
+        typename Q::scalar max_coordinate() const noexcept;
+
+        // Mapping -------------------------------------------------------------
+
+        /**
+         * Returns the grid point nearest to p. Points outside the domain are
+         * clamped to it.
+         */
+        quantized_point_type quantize(point_type const& p) const noexcept;
+
+        /**
+         * Returns the point in the domain corresponding to grid point q.
+         */
+        point_type dequantize(quantized_point_type const& q) const noexcept;
+
+      private:
+        box_type domain_;
+        metric_type resolution_;
+        metric_type inverse_resolution_;
+    };
+}
+
+#include "quantizer.ipp"
+
+#endif
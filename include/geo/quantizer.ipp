@@ -0,0 +1,97 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstdint>
+
+#include "box.hpp"
+#include "point.hpp"
+#include "quantizer.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K, typename Q>
+    quantizer<K, Q>::quantizer() noexcept
+        : quantizer(box_type {})
+    {
+    }
+
+    template<typename K, typename Q>
+    quantizer<K, Q>::quantizer(box_type const& domain) noexcept
+        : domain_ {domain}
+    {
+        auto const span = domain.diagonal_span();
+        metric_type longest = 0;
+        for (unsigned i = 0; i < dimension; ++i) {
+            longest = std::max(longest, metric_type(span[i]));
+        }
+
+        // A degenerate domain maps every point to the grid origin.
+        resolution_ = longest / metric_type(max_coordinate());
+        inverse_resolution_ = longest > 0 ? metric_type(1) / resolution_ : metric_type(0);
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K, typename Q>
+    auto quantizer<K, Q>::domain() const noexcept -> box_type
+    {
+        return domain_;
+    }
+
+    template<typename K, typename Q>
+    auto quantizer<K, Q>::resolution() const noexcept -> metric_type
+    {
+        return resolution_;
+    }
+
+    template<typename K, typename Q>
+    typename Q::scalar quantizer<K, Q>::max_coordinate() const noexcept
+    {
+        return static_cast<typename Q::scalar>(
+            (std::uint64_t(1) << Q::coordinate_bits) - 1
+        );
+    }
+
+    // Mapping -----------------------------------------------------------------
+
+    template<typename K, typename Q>
+    auto quantizer<K, Q>::quantize(point_type const& p) const noexcept
+    -> quantized_point_type
+    {
+        using scalar_type = typename Q::scalar;
+
+        metric_type const limit = metric_type(max_coordinate());
+        point_type const low = domain_.lowest_vertex();
+
+        // The offset is clamped to be non-negative, so adding one half and
+        // truncating rounds to nearest.
+        quantized_point_type q;
+        for (unsigned i = 0; i < dimension; ++i) {
+            metric_type const offset =
+                (metric_type(p[i]) - metric_type(low[i])) * inverse_resolution_;
+            metric_type const clamped = std::min(std::max(offset, metric_type(0)), limit);
+            q[i] = static_cast<scalar_type>(static_cast<std::int64_t>(clamped + metric_type(0.5)));
+        }
+        return q;
+    }
+
+    template<typename K, typename Q>
+    auto quantizer<K, Q>::dequantize(quantized_point_type const& q) const noexcept
+    -> point_type
+    {
+        using scalar_type = typename K::scalar;
+
+        point_type const low = domain_.lowest_vertex();
+
+        point_type p;
+        for (unsigned i = 0; i < dimension; ++i) {
+            p[i] = static_cast<scalar_type>(
+                metric_type(low[i]) + metric_type(q[i]) * resolution_
+            );
+        }
+        return p;
+    }
+}
@@ -57,6 +57,13 @@ namespace geo
 
         using mixin::mixin;
 
+        // Both mixins declare compound assignment operators. Bring them into
+        // one scope so that overload resolution, not name lookup, picks one.
+        using linear_operations<scaling_transformation<K>, K>::operator*=;
+        using linear_operations<scaling_transformation<K>, K>::operator/=;
+        using multiplicative_operations<scaling_transformation<K>, K>::operator*=;
+        using multiplicative_operations<scaling_transformation<K>, K>::operator/=;
+
         /**
          * Default constructor creates an identity transformation.
          */
@@ -31,8 +31,10 @@ namespace geo
     -> vector_type
     {
         vector_type result = v;
-        for (unsigned i = 0; i < dimension; ++i) {
-            result[i] *= (*this)[i];
+        scalar_type* const lanes = result.data();
+        scalar_type const* const factors = this->data();
+        for (unsigned i = 0; i < mixin::storage_dimension; ++i) {
+            lanes[i] *= factors[i];
         }
         return result;
     }
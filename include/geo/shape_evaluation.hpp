@@ -0,0 +1,50 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Result of fused evaluation of analytic shape queries.
+//
+// This header has no inline implementation file (*.ipp).
+//
+
+#ifndef GEO_SHAPE_EVALUATION_HPP
+#define GEO_SHAPE_EVALUATION_HPP
+
+#include "scaling_transformation.hpp"
+#include "vector.hpp"
+
+namespace geo
+{
+    /**
+     * Values of all analytic queries of a shape at a point, as returned by
+     * evaluate() member function of shapes. SkinMap is the type of the skin
+     * map transformation, which is a general linear transformation for
+     * rotated shapes.
+     */
+    template<typename K, typename SkinMap = scaling_transformation<K>>
+    struct shape_evaluation
+    {
+        /**
+         * Value of the implicit function.
+         */
+        typename K::metric potential;
+
+        /**
+         * Gradient of the implicit function.
+         */
+        vector<K> gradient;
+
+        /**
+         * Oriented distance to the surface.
+         */
+        typename K::metric oriented_distance;
+
+        /**
+         * Transformation mapping centric position vector to surface position
+         * vector.
+         */
+        SkinMap skin_map;
+    };
+}
+
+#endif
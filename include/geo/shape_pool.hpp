@@ -0,0 +1,211 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Dense collection of shapes addressed by stable handles.
+//
+
+#ifndef GEO_SHAPE_POOL_HPP
+#define GEO_SHAPE_POOL_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "box.hpp"
+#include "internal/aligned_allocator.hpp"
+
+namespace geo
+{
+    /**
+     * Collection of shapes stored contiguously and addressed by handles that
+     * stay valid until the shape is erased.
+     *
+     * Shapes live in a dense array in no particular order. Erasing a shape
+     * moves the last shape into its slot, so the array never has holes, and
+     * the handle of the moved shape is remapped to its new slot. Handles of
+     * erased shapes are recycled through a free list, so a workload that
+     * creates and destroys shapes at a steady rate does not grow the pool.
+     * A handle combines a recycled index in its low 32 bits with a generation
+     * in its high 32 bits, which is bumped when the shape is erased. So a
+     * handle kept after erase() does not refer to the shape later inserted
+     * into the same slot: contains() returns false for it. Only after 2^32
+     * reuses of a slot does a stale handle become valid again.
+     *
+     * The bounding boxes of the shapes are cached in a parallel array. A box
+     * is marked stale when its shape is inserted or modified and computed on
+     * the next call to bounding_boxes(), so that spatial indexes can rebuild
+     * from dense memory. The Shape type must have a bounding_box() function
+     * found by argument-dependent lookup, like box, sphere and ellipsoid.
+     */
+    template<typename Shape>
+    struct shape_pool
+    {
+        /**
+         * Type of stored shapes.
+         */
+        using shape_type = Shape;
+
+        /**
+         * Kernel of the shape type.
+         */
+        using kernel = typename Shape::kernel;
+
+        /**
+         * Type of bounding boxes.
+         */
+        using box_type = box<kernel>;
+
+        /**
+         * Type for handles of shapes.
+         */
+        using handle_type = std::uint64_t;
+
+        /**
+         * Type of dense iterators.
+         */
+        using const_iterator = shape_type const*;
+
+        /**
+         * Handle that never refers to a shape.
+         */
+        static constexpr handle_type null_handle = handle_type(-1);
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty pool.
+         */
+        shape_pool() = default;
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of shapes.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns true if the pool has no shapes.
+         */
+        bool empty() const noexcept;
+
+        /**
+         * Returns true if handle refers to a shape of the pool, that is, it
+         * was returned by insert() and the shape has not been erased since.
+         */
+        bool contains(handle_type handle) const noexcept;
+
+        // Element access ------------------------------------------------------
+
+        /**
+         * Returns the shape of given handle. Assertion fails if the handle
+         * does not refer to a shape.
+         */
+        shape_type const& operator[](handle_type handle) const;
+
+        /**
+         * Returns a mutable reference to the shape of given handle and marks
+         * its bounding box stale. The reference is invalidated by any other
+         * modifier of the pool.
+         */
+        shape_type& modify(handle_type handle);
+
+        /**
+         * Returns the position of the shape of given handle in the dense
+         * array. The position changes when another shape is erased.
+         */
+        std::size_t index(handle_type handle) const;
+
+        /**
+         * Returns the handle of the shape at given position of the dense
+         * array.
+         */
+        handle_type handle(std::size_t index) const;
+
+        // Dense access --------------------------------------------------------
+
+        /**
+         * Returns the dense array of shapes.
+         */
+        shape_type const* data() const noexcept;
+
+        /**
+         * Returns the dense array of handles, parallel to data().
+         */
+        handle_type const* handles() const noexcept;
+
+        /**
+         * Returns the dense array of bounding boxes, parallel to data(),
+         * after computing the stale ones.
+         */
+        box_type const* bounding_boxes();
+
+        /**
+         * Returns an iterator to the first shape of the dense array.
+         */
+        const_iterator begin() const noexcept;
+
+        /**
+         * Returns an iterator past the last shape of the dense array.
+         */
+        const_iterator end() const noexcept;
+
+        // Modifiers -----------------------------------------------------------
+
+        /**
+         * Reserves storage for given number of shapes, so that inserting up
+         * to that many shapes does not reallocate.
+         */
+        void reserve(std::size_t capacity);
+
+        /**
+         * Adds a shape and returns its handle. Assertion fails if 2^32 - 1
+         * handles are live.
+         */
+        handle_type insert(shape_type const& shape);
+
+        /**
+         * Erases the shape of given handle. The last shape of the dense array
+         * moves to the slot of the erased one. Assertion fails if the handle
+         * does not refer to a shape.
+         */
+        void erase(handle_type handle);
+
+        /**
+         * Erases all shapes. Handles are reissued from scratch, so handles
+         * obtained before the call must not be used afterwards, and storage
+         * is kept for reuse.
+         */
+        void clear() noexcept;
+
+      private:
+        using slot_type = std::uint32_t;
+        using generation_type = std::uint32_t;
+
+        static constexpr std::size_t null_position = std::size_t(-1);
+
+        static handle_type make_handle(slot_type slot,
+                                       generation_type generation) noexcept;
+
+        static slot_type slot_of(handle_type handle) noexcept;
+
+        std::vector<shape_type, aligned_allocator<shape_type>> shapes_;
+        std::vector<box_type, aligned_allocator<box_type>> boxes_;
+        std::vector<handle_type> handles_;
+
+        // Per handle slot: position in the dense arrays, or null_position if
+        // free, current generation, and whether the slot is queued in
+        // stale_slots_.
+        std::vector<std::size_t> positions_;
+        std::vector<generation_type> generations_;
+        std::vector<unsigned char> queued_;
+
+        std::vector<slot_type> free_slots_;
+        std::vector<slot_type> stale_slots_;
+    };
+}
+
+#include "shape_pool.ipp"
+
+#endif
@@ -0,0 +1,214 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "shape_pool.hpp"
+
+namespace geo
+{
+    template<typename Shape>
+    constexpr typename shape_pool<Shape>::handle_type shape_pool<Shape>::null_handle;
+
+    template<typename Shape>
+    constexpr std::size_t shape_pool<Shape>::null_position;
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename Shape>
+    std::size_t shape_pool<Shape>::size() const noexcept
+    {
+        return shapes_.size();
+    }
+
+    template<typename Shape>
+    bool shape_pool<Shape>::empty() const noexcept
+    {
+        return shapes_.empty();
+    }
+
+    template<typename Shape>
+    bool shape_pool<Shape>::contains(handle_type handle) const noexcept
+    {
+        slot_type const slot = slot_of(handle);
+        return slot < positions_.size() && positions_[slot] != null_position &&
+               generations_[slot] == generation_type(handle >> 32);
+    }
+
+    // Element access ----------------------------------------------------------
+
+    template<typename Shape>
+    auto shape_pool<Shape>::operator[](handle_type handle) const -> shape_type const&
+    {
+        return shapes_[index(handle)];
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::modify(handle_type handle) -> shape_type&
+    {
+        std::size_t const position = index(handle);
+        slot_type const slot = slot_of(handle);
+        if (!queued_[slot]) {
+            queued_[slot] = 1;
+            stale_slots_.push_back(slot);
+        }
+        return shapes_[position];
+    }
+
+    template<typename Shape>
+    std::size_t shape_pool<Shape>::index(handle_type handle) const
+    {
+        GEO_ASSERT(contains(handle));
+        return positions_[slot_of(handle)];
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::handle(std::size_t index) const -> handle_type
+    {
+        GEO_ASSERT(index < handles_.size());
+        return handles_[index];
+    }
+
+    // Dense access ------------------------------------------------------------
+
+    template<typename Shape>
+    auto shape_pool<Shape>::data() const noexcept -> shape_type const*
+    {
+        return shapes_.data();
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::handles() const noexcept -> handle_type const*
+    {
+        return handles_.data();
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::bounding_boxes() -> box_type const*
+    {
+        // A queued slot may have been freed, and possibly reissued, since it
+        // was queued. Free ones are skipped and reissued ones hold a shape
+        // whose box is stale anyway.
+        for (slot_type const slot : stale_slots_) {
+            queued_[slot] = 0;
+            std::size_t const position = positions_[slot];
+            if (position != null_position) {
+                boxes_[position] = bounding_box(shapes_[position]);
+            }
+        }
+        stale_slots_.clear();
+        return boxes_.data();
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::begin() const noexcept -> const_iterator
+    {
+        return shapes_.data();
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::end() const noexcept -> const_iterator
+    {
+        return shapes_.data() + shapes_.size();
+    }
+
+    // Modifiers ---------------------------------------------------------------
+
+    template<typename Shape>
+    void shape_pool<Shape>::reserve(std::size_t capacity)
+    {
+        shapes_.reserve(capacity);
+        boxes_.reserve(capacity);
+        handles_.reserve(capacity);
+        positions_.reserve(capacity);
+        generations_.reserve(capacity);
+        queued_.reserve(capacity);
+        stale_slots_.reserve(capacity);
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::insert(shape_type const& shape) -> handle_type
+    {
+        // The largest slot is kept unused so that null_handle never matches.
+        slot_type slot;
+        if (free_slots_.empty()) {
+            GEO_ASSERT(positions_.size() < std::numeric_limits<slot_type>::max());
+            slot = slot_type(positions_.size());
+            positions_.push_back(null_position);
+            generations_.push_back(0);
+            queued_.push_back(0);
+        } else {
+            slot = free_slots_.back();
+            free_slots_.pop_back();
+        }
+
+        handle_type const handle = make_handle(slot, generations_[slot]);
+        shapes_.push_back(shape);
+        boxes_.emplace_back();
+        handles_.push_back(handle);
+        positions_[slot] = shapes_.size() - 1;
+
+        if (!queued_[slot]) {
+            queued_[slot] = 1;
+            stale_slots_.push_back(slot);
+        }
+        return handle;
+    }
+
+    template<typename Shape>
+    void shape_pool<Shape>::erase(handle_type handle)
+    {
+        std::size_t const position = index(handle);
+        std::size_t const last = shapes_.size() - 1;
+
+        if (position != last) {
+            handle_type const moved = handles_[last];
+            shapes_[position] = std::move(shapes_[last]);
+            boxes_[position] = boxes_[last];
+            handles_[position] = moved;
+            positions_[slot_of(moved)] = position;
+        }
+        shapes_.pop_back();
+        boxes_.pop_back();
+        handles_.pop_back();
+
+        slot_type const slot = slot_of(handle);
+        positions_[slot] = null_position;
+        ++generations_[slot];
+        free_slots_.push_back(slot);
+    }
+
+    template<typename Shape>
+    void shape_pool<Shape>::clear() noexcept
+    {
+        shapes_.clear();
+        boxes_.clear();
+        handles_.clear();
+        positions_.clear();
+        generations_.clear();
+        queued_.clear();
+        free_slots_.clear();
+        stale_slots_.clear();
+    }
+
+    // Handles -----------------------------------------------------------------
+
+    template<typename Shape>
+    auto shape_pool<Shape>::make_handle(slot_type slot, generation_type generation) noexcept
+        -> handle_type
+    {
+        return handle_type(generation) << 32 | slot;
+    }
+
+    template<typename Shape>
+    auto shape_pool<Shape>::slot_of(handle_type handle) noexcept -> slot_type
+    {
+        return slot_type(handle);
+    }
+}
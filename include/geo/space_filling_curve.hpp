@@ -0,0 +1,98 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Morton and Hilbert space-filling curves and spatial sorting.
+//
+
+#ifndef GEO_SPACE_FILLING_CURVE_HPP
+#define GEO_SPACE_FILLING_CURVE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "box.hpp"
+#include "execution.hpp"
+#include "point.hpp"
+
+namespace geo
+{
+    /**
+     * Space-filling curves usable as sort keys.
+     */
+    enum class space_filling_curve
+    {
+        /**
+         * Z-order curve. Cheap to compute, but consecutive keys may jump
+         * across the domain at the boundaries of octants.
+         */
+        morton,
+
+        /**
+         * Hilbert curve. Consecutive keys are always adjacent cells, so it
+         * gives better locality at a slightly higher cost.
+         */
+        hilbert
+    };
+
+    /**
+     * Number of bits each coordinate is quantized to by the curves in
+     * dimension n: 64 / n, but at most 32.
+     */
+    inline constexpr
+    unsigned curve_bits(unsigned n) noexcept
+    {
+        return 64 / n < 32 ? 64 / n : 32;
+    }
+
+    /**
+     * Computes the Morton code of p relative to domain.
+     *
+     * Each coordinate is mapped linearly from the extent of domain along
+     * its axis to an integer of curve_bits(K::dimension) bits, clamped to
+     * the domain, and the bits of all coordinates are interleaved with the
+     * bits of the first axis most significant. BMI2 pdep is used if the
+     * code is compiled for a CPU that supports it.
+     */
+    template<typename K>
+    std::uint64_t morton_code(point<K> const& p, box<K> const& domain) noexcept;
+
+    /**
+     * Computes the Hilbert code of p relative to domain. Coordinates are
+     * quantized in the same way as morton_code().
+     */
+    template<typename K>
+    std::uint64_t hilbert_code(point<K> const& p, box<K> const& domain) noexcept;
+
+    /**
+     * Reorders points in a random access range along a space-filling curve
+     * over domain, so that points close in space are likely to be close in
+     * the range. Returns the permutation: the i-th point after sorting was
+     * at index result[i] before sorting.
+     *
+     * Keys are sorted by a stable least significant digit radix sort that
+     * skips digits shared by all keys. Codes are computed with BMI2 pdep if
+     * the running CPU supports it.
+     */
+    template<typename K, typename RandomIterator>
+    std::vector<std::size_t>
+    spatial_sort(RandomIterator first, RandomIterator last,
+                 box<K> const& domain,
+                 space_filling_curve curve = space_filling_curve::hilbert);
+
+    /**
+     * Same as above under an execution policy. Parallel policies compute
+     * keys, radix-sort them and permute points across threads. The result
+     * is the same as the sequential one.
+     */
+    template<typename K, typename Policy, typename RandomIterator>
+    detail::enable_if_execution_policy<Policy, std::vector<std::size_t>>
+    spatial_sort(Policy&& policy, RandomIterator first, RandomIterator last,
+                 box<K> const& domain,
+                 space_filling_curve curve = space_filling_curve::hilbert);
+}
+
+#include "space_filling_curve.ipp"
+
+#endif
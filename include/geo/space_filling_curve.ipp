@@ -0,0 +1,420 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <type_traits>
+#include <vector>
+
+#include "box.hpp"
+#include "execution.hpp"
+#include "internal/aligned_allocator.hpp"
+#include "internal/simd.hpp"
+#include "point.hpp"
+#include "space_filling_curve.hpp"
+
+#if GEO_SIMD_X86
+# include <immintrin.h>
+#endif
+
+namespace geo
+{
+    namespace detail
+    {
+        // Quantization --------------------------------------------------------
+
+        // Maps coordinates in a box to integers of curve_bits() bits. The
+        // arithmetic is done in double so that any kernel can be used.
+        template<typename K>
+        struct curve_grid
+        {
+            static constexpr unsigned dimension = K::dimension;
+            static constexpr unsigned bits = curve_bits(K::dimension);
+
+            static_assert(K::dimension <= 64, "");
+
+            explicit
+            curve_grid(box<K> const& domain) noexcept
+            {
+                constexpr double cells = double(std::uint64_t(1) << bits);
+
+                point<K> const low_vertex = domain.lowest_vertex();
+                point<K> const high_vertex = domain.highest_vertex();
+                for (unsigned i = 0; i < dimension; ++i) {
+                    double const span = double(high_vertex[i]) - double(low_vertex[i]);
+                    low[i] = double(low_vertex[i]);
+                    scale[i] = span > 0 ? cells / span : 0;
+                }
+            }
+
+            void quantize(point<K> const& p, std::uint32_t* coords) const noexcept
+            {
+                constexpr double limit = double((std::uint64_t(1) << bits) - 1);
+
+                for (unsigned i = 0; i < dimension; ++i) {
+                    // Written so that NaN maps to zero.
+                    double const x = (double(p[i]) - low[i]) * scale[i];
+                    double const clamped = x > 0 ? (x < limit ? x : limit) : 0;
+                    coords[i] = static_cast<std::uint32_t>(clamped);
+                }
+            }
+
+            double low[K::dimension];
+            double scale[K::dimension];
+        };
+
+        // Bit interleaving ----------------------------------------------------
+
+        // Moves bit k of x to bit k * N for the low curve_bits(N) bits.
+        template<unsigned N>
+        constexpr
+        std::uint64_t spread_bits(std::uint64_t x, std::integral_constant<unsigned, N>) noexcept
+        {
+            std::uint64_t result = 0;
+            for (unsigned k = 0; k < curve_bits(N); ++k) {
+                result |= ((x >> k) & 1) << (k * N);
+            }
+            return result;
+        }
+
+        inline constexpr
+        std::uint64_t spread_bits(std::uint64_t x, std::integral_constant<unsigned, 1>) noexcept
+        {
+            return x;
+        }
+
+        inline constexpr
+        std::uint64_t spread_bits(std::uint64_t x, std::integral_constant<unsigned, 2>) noexcept
+        {
+            x &= 0x00000000ffffffff;
+            x = (x | x << 16) & 0x0000ffff0000ffff;
+            x = (x | x << 8) & 0x00ff00ff00ff00ff;
+            x = (x | x << 4) & 0x0f0f0f0f0f0f0f0f;
+            x = (x | x << 2) & 0x3333333333333333;
+            x = (x | x << 1) & 0x5555555555555555;
+            return x;
+        }
+
+        inline constexpr
+        std::uint64_t spread_bits(std::uint64_t x, std::integral_constant<unsigned, 3>) noexcept
+        {
+            x &= 0x00000000001fffff;
+            x = (x | x << 32) & 0x001f00000000ffff;
+            x = (x | x << 16) & 0x001f0000ff0000ff;
+            x = (x | x << 8) & 0x100f00f00f00f00f;
+            x = (x | x << 4) & 0x10c30c30c30c30c3;
+            x = (x | x << 2) & 0x1249249249249249;
+            return x;
+        }
+
+        // Bits of the code holding the coordinate of given axis. The first
+        // axis is the most significant one within each group of N bits.
+        template<unsigned N>
+        constexpr
+        std::uint64_t axis_mask(unsigned axis) noexcept
+        {
+            return spread_bits((std::uint64_t(1) << curve_bits(N)) - 1,
+                               std::integral_constant<unsigned, N>{}) << (N - 1 - axis);
+        }
+
+        struct portable_deposit
+        {
+        };
+
+        struct bmi2_deposit
+        {
+        };
+
+        template<unsigned N>
+        std::uint64_t interleave(std::uint32_t const* coords, portable_deposit) noexcept
+        {
+            std::uint64_t code = 0;
+            for (unsigned d = 0; d < N; ++d) {
+                code |= spread_bits(coords[d], std::integral_constant<unsigned, N>{})
+                        << (N - 1 - d);
+            }
+            return code;
+        }
+
+#if GEO_SIMD_X86
+        template<unsigned N>
+        __attribute__((target("bmi2"), always_inline)) inline
+        std::uint64_t interleave(std::uint32_t const* coords, bmi2_deposit) noexcept
+        {
+            std::uint64_t code = 0;
+            for (unsigned d = 0; d < N; ++d) {
+                code |= _pdep_u64(coords[d], axis_mask<N>(d));
+            }
+            return code;
+        }
+#endif
+
+        // Transforms coordinates in place so that interleaving them gives
+        // the Hilbert index. This is AxestoTranspose from J. Skilling,
+        // "Programming the Hilbert curve", AIP Conf. Proc. 707 (2004).
+        template<unsigned N>
+        void hilbert_transpose(std::uint32_t* x) noexcept
+        {
+            constexpr std::uint32_t top = std::uint32_t(1) << (curve_bits(N) - 1);
+
+            // The branches of the original are replaced by masks, since the
+            // bits of random points make them unpredictable.
+
+            // Inverse undo: invert the low bits of x[0] if bit q of x[i] is
+            // set, otherwise exchange the low bits of x[0] and x[i].
+            // The first coordinate is held in a local so that it is not
+            // reloaded through the aliasing x[i].
+            std::uint32_t first = x[0];
+            for (std::uint32_t q = top; q > 1; q >>= 1) {
+                std::uint32_t const p = q - 1;
+                first ^= p & (std::uint32_t(0) - ((first & q) != 0));
+                for (unsigned i = 1; i < N; ++i) {
+                    std::uint32_t const set = std::uint32_t(0) - ((x[i] & q) != 0);
+                    std::uint32_t const t = (first ^ x[i]) & p & ~set;
+                    first ^= (p & set) | t;
+                    x[i] ^= t;
+                }
+            }
+            x[0] = first;
+
+            // Gray encode.
+            for (unsigned i = 1; i < N; ++i) {
+                x[i] ^= x[i - 1];
+            }
+            std::uint32_t t = 0;
+            for (std::uint32_t q = top; q > 1; q >>= 1) {
+                t ^= (q - 1) & (std::uint32_t(0) - ((x[N - 1] & q) != 0));
+            }
+            for (unsigned i = 0; i < N; ++i) {
+                x[i] ^= t;
+            }
+        }
+
+        // Computes the coordinates whose interleaved bits form the code of p
+        // on given curve.
+        template<typename K>
+        void curve_coordinates(point<K> const& p, curve_grid<K> const& grid,
+                               space_filling_curve curve,
+                               std::uint32_t* coords) noexcept
+        {
+            grid.quantize(p, coords);
+            if (curve == space_filling_curve::hilbert) {
+                hilbert_transpose<K::dimension>(coords);
+            }
+        }
+
+        template<typename K>
+        std::uint64_t curve_code(point<K> const& p, box<K> const& domain,
+                                 space_filling_curve curve) noexcept
+        {
+            // The deposit method compiled into this translation unit.
+#if GEO_SIMD_X86 && defined(__BMI2__)
+            using deposit = bmi2_deposit;
+#else
+            using deposit = portable_deposit;
+#endif
+            std::uint32_t coords[K::dimension];
+            curve_coordinates(p, curve_grid<K> {domain}, curve, coords);
+            return interleave<K::dimension>(coords, deposit {});
+        }
+
+        // Sorting -------------------------------------------------------------
+
+        // Minimum number of points worth a thread.
+        constexpr std::size_t spatial_sort_grain = std::size_t(1) << 15;
+
+        struct curve_entry
+        {
+            std::uint64_t code;
+            std::size_t index;
+        };
+
+        // The loop is repeated in both entry points rather than shared. A
+        // shared loop would be a generic function calling the bmi2 overload
+        // of interleave, which GCC and Clang do not inline into a caller
+        // lacking its target. The generic helpers are inlined into the bmi2
+        // loop as usual, since its target includes theirs.
+
+        template<typename K, typename Iterator>
+        void curve_entries_portable(Iterator first, std::size_t begin, std::size_t end,
+                                    curve_grid<K> const& grid, space_filling_curve curve,
+                                    curve_entry* out)
+        {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::uint32_t coords[K::dimension];
+                curve_coordinates<K>(first[static_cast<std::ptrdiff_t>(i)], grid, curve, coords);
+                out[i] = curve_entry {interleave<K::dimension>(coords, portable_deposit {}), i};
+            }
+        }
+
+#if GEO_SIMD_X86
+        template<typename K, typename Iterator>
+        __attribute__((target("bmi2")))
+        void curve_entries_bmi2(Iterator first, std::size_t begin, std::size_t end,
+                                curve_grid<K> const& grid, space_filling_curve curve,
+                                curve_entry* out)
+        {
+            for (std::size_t i = begin; i < end; ++i) {
+                std::uint32_t coords[K::dimension];
+                curve_coordinates<K>(first[static_cast<std::ptrdiff_t>(i)], grid, curve, coords);
+                out[i] = curve_entry {interleave<K::dimension>(coords, bmi2_deposit {}), i};
+            }
+        }
+
+        inline
+        bool has_bmi2() noexcept
+        {
+            static bool const supported = [] {
+                __builtin_cpu_init();
+                return __builtin_cpu_supports("bmi2") != 0;
+            }();
+            return supported;
+        }
+#endif
+
+        // Computes the entries of points [begin, end) of the range starting
+        // at first, picking pdep at runtime if the CPU supports it.
+        template<typename K, typename Iterator>
+        void curve_entries(Iterator first, std::size_t begin, std::size_t end,
+                           curve_grid<K> const& grid, space_filling_curve curve,
+                           curve_entry* out)
+        {
+#if GEO_SIMD_X86
+            if (has_bmi2()) {
+                curve_entries_bmi2<K>(first, begin, end, grid, curve, out);
+                return;
+            }
+#endif
+            curve_entries_portable<K>(first, begin, end, grid, curve, out);
+        }
+
+        // Stable least significant digit radix sort of entries by the low
+        // key_bits bits of their codes. Each pass counts digits per chunk,
+        // then scatters every chunk to its own slots of each digit, so the
+        // result does not depend on the number of threads.
+        inline
+        void radix_sort(unsigned threads, std::vector<curve_entry>& entries,
+                        unsigned key_bits)
+        {
+            constexpr unsigned digit_bits = 8;
+            constexpr std::size_t radix = std::size_t(1) << digit_bits;
+
+            std::size_t const count = entries.size();
+            std::vector<curve_entry> buffer(count);
+            std::vector<std::array<std::size_t, radix>> offsets(threads);
+
+            for (unsigned shift = 0; shift < key_bits; shift += digit_bits) {
+                parallel_chunks(threads, count, [&](unsigned chunk,
+                                                    std::size_t begin,
+                                                    std::size_t end) {
+                    std::array<std::size_t, radix>& histogram = offsets[chunk];
+                    histogram.fill(0);
+                    for (std::size_t i = begin; i < end; ++i) {
+                        histogram[(entries[i].code >> shift) & (radix - 1)]++;
+                    }
+                });
+
+                // Skip a digit shared by all keys: the pass would not move
+                // anything.
+                bool shared = false;
+                std::size_t offset = 0;
+                for (std::size_t digit = 0; digit < radix; ++digit) {
+                    std::size_t total = 0;
+                    for (auto& histogram : offsets) {
+                        std::size_t const n = histogram[digit];
+                        histogram[digit] = offset + total;
+                        total += n;
+                    }
+                    shared = shared || total == count;
+                    offset += total;
+                }
+                if (shared) {
+                    continue;
+                }
+
+                parallel_chunks(threads, count, [&](unsigned chunk,
+                                                    std::size_t begin,
+                                                    std::size_t end) {
+                    std::array<std::size_t, radix>& next = offsets[chunk];
+                    for (std::size_t i = begin; i < end; ++i) {
+                        curve_entry const& entry = entries[i];
+                        buffer[next[(entry.code >> shift) & (radix - 1)]++] = entry;
+                    }
+                });
+                entries.swap(buffer);
+            }
+        }
+
+        template<typename K, typename Policy, typename RandomIterator>
+        std::vector<std::size_t>
+        spatial_sort(Policy const& policy, RandomIterator first, RandomIterator last,
+                     box<K> const& domain, space_filling_curve curve)
+        {
+            using value_type = typename std::iterator_traits<RandomIterator>::value_type;
+
+            auto const count = static_cast<std::size_t>(std::distance(first, last));
+            if (count == 0) {
+                return {};
+            }
+            unsigned const threads = thread_count(policy, count, spatial_sort_grain);
+
+            curve_grid<K> const grid {domain};
+            std::vector<curve_entry> entries(count);
+            parallel_chunks(threads, count, [&](unsigned,
+                                                std::size_t begin,
+                                                std::size_t end) {
+                curve_entries<K>(first, begin, end, grid, curve, entries.data());
+            });
+
+            radix_sort(threads, entries, curve_bits(K::dimension) * K::dimension);
+
+            std::vector<value_type, aligned_allocator<value_type>> const source(first, last);
+            std::vector<std::size_t> permutation(count);
+            parallel_chunks(threads, count, [&](unsigned,
+                                                std::size_t begin,
+                                                std::size_t end) {
+                for (std::size_t i = begin; i < end; ++i) {
+                    std::size_t const index = entries[i].index;
+                    first[static_cast<std::ptrdiff_t>(i)] = source[index];
+                    permutation[i] = index;
+                }
+            });
+
+            return permutation;
+        }
+    }
+
+    // Codes -------------------------------------------------------------------
+
+    template<typename K>
+    std::uint64_t morton_code(point<K> const& p, box<K> const& domain) noexcept
+    {
+        return detail::curve_code(p, domain, space_filling_curve::morton);
+    }
+
+    template<typename K>
+    std::uint64_t hilbert_code(point<K> const& p, box<K> const& domain) noexcept
+    {
+        return detail::curve_code(p, domain, space_filling_curve::hilbert);
+    }
+
+    // Sorting -----------------------------------------------------------------
+
+    template<typename K, typename RandomIterator>
+    std::vector<std::size_t>
+    spatial_sort(RandomIterator first, RandomIterator last,
+                 box<K> const& domain, space_filling_curve curve)
+    {
+        return detail::spatial_sort(execution::seq, first, last, domain, curve);
+    }
+
+    template<typename K, typename Policy, typename RandomIterator>
+    detail::enable_if_execution_policy<Policy, std::vector<std::size_t>>
+    spatial_sort(Policy&& policy, RandomIterator first, RandomIterator last,
+                 box<K> const& domain, space_filling_curve curve)
+    {
+        return detail::spatial_sort(policy, first, last, domain, curve);
+    }
+}
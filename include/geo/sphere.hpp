@@ -11,6 +11,7 @@
 #include "box.hpp"
 #include "point.hpp"
 #include "scaling_transformation.hpp"
+#include "shape_evaluation.hpp"
 #include "vector.hpp"
 
 namespace geo
@@ -51,6 +52,11 @@ namespace geo
          */
         using scaling_type = scaling_transformation<K>;
 
+        /**
+         * Type of fused evaluation result.
+         */
+        using evaluation_type = shape_evaluation<K>;
+
         /**
          * Dimension of the underlying Euclidean space.
          */
@@ -87,6 +93,7 @@ namespace geo
         /**
          * Returns the radius.
          */
+        constexpr
         metric_type radius() const noexcept;
 
         // Analytic query ------------------------------------------------------
@@ -126,8 +133,15 @@ namespace geo
         constexpr
         scaling_type skin_map(point_type const& p) const noexcept;
 
+        /**
+         * Evaluates potential, gradient, oriented distance and skin map at
+         * once, sharing the displacement from the center and its norm.
+         */
+        evaluation_type evaluate(point_type const& p) const noexcept;
+
       private:
         point_type center_ {};
+        metric_type radius_ {scalar_type(1)};
         metric_type squared_radius_ {scalar_type(1)};
     };
 
@@ -136,6 +150,26 @@ namespace geo
      */
     template<typename K>
     box<K> bounding_box(sphere<K> const& s) noexcept;
+
+    /**
+     * Determines if two spheres share at least one point. Spheres touching
+     * at the boundary are considered intersecting.
+     */
+    template<typename K>
+    constexpr
+    bool intersects(sphere<K> const& a, sphere<K> const& b) noexcept;
+
+    /**
+     * Determines if a sphere and a box share at least one point. Shapes
+     * touching at the boundary are considered intersecting.
+     */
+    template<typename K>
+    constexpr
+    bool intersects(sphere<K> const& s, box<K> const& b) noexcept;
+
+    template<typename K>
+    constexpr
+    bool intersects(box<K> const& b, sphere<K> const& s) noexcept;
 }
 
 #include "sphere.ipp"
@@ -13,6 +13,7 @@ namespace geo
     constexpr
     sphere<K>::sphere(point_type const& center, metric_type radius)
         : center_ {center}
+        , radius_ {radius}
         , squared_radius_ {radius * radius}
     {
         GEO_ASSERT(radius >= 0);
@@ -35,9 +36,10 @@ namespace geo
     }
 
     template<typename K>
+    constexpr
     auto sphere<K>::radius() const noexcept -> metric_type
     {
-        return K::sqrt(squared_radius_);
+        return radius_;
     }
 
     // Analytic query ------------------------------------------------------
@@ -67,7 +69,22 @@ namespace geo
     constexpr
     auto sphere<K>::skin_map(point_type const& p) const noexcept -> scaling_type
     {
-        return scalar_type(1) - radius() / distance(p, center());
+        return static_cast<scalar_type>(metric_type(1) - radius() / distance(p, center()));
+    }
+
+    template<typename K>
+    auto sphere<K>::evaluate(point_type const& p) const noexcept -> evaluation_type
+    {
+        vector_type const r = p - center();
+        metric_type const squared_dist = squared_norm(r);
+        metric_type const dist = K::sqrt(squared_dist);
+
+        evaluation_type result;
+        result.potential = squared_dist - squared_radius();
+        result.gradient = scalar_type(2) * r;
+        result.oriented_distance = dist - radius();
+        result.skin_map = static_cast<scalar_type>(metric_type(1) - radius() / dist);
+        return result;
     }
 
     // Basic algorithms --------------------------------------------------------
@@ -76,11 +93,36 @@ namespace geo
     box<K> bounding_box(sphere<K> const& s) noexcept
     {
         vector<K> semi_diagonal;
-        auto const radius = s.radius();
+        auto const radius = static_cast<typename K::scalar>(s.radius());
         for (auto& e : semi_diagonal) {
             e = radius;
         }
         return box<K>{s.center() - semi_diagonal,
                       s.center() + semi_diagonal};
     }
+
+    // Both tests compare squared distances, so they involve no square root
+    // and no branch.
+
+    template<typename K>
+    constexpr
+    bool intersects(sphere<K> const& a, sphere<K> const& b) noexcept
+    {
+        auto const reach = a.radius() + b.radius();
+        return squared_distance(a.center(), b.center()) <= reach * reach;
+    }
+
+    template<typename K>
+    constexpr
+    bool intersects(sphere<K> const& s, box<K> const& b) noexcept
+    {
+        return squared_distance(b, s.center()) <= s.squared_radius();
+    }
+
+    template<typename K>
+    constexpr
+    bool intersects(box<K> const& b, sphere<K> const& s) noexcept
+    {
+        return intersects(s, b);
+    }
 }
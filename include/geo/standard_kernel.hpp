@@ -15,14 +15,41 @@
 
 namespace geo
 {
+    /**
+     * Storage policy that stores exactly n coordinates without padding.
+     */
+    struct packed_storage
+    {
+    };
+
+    /**
+     * Storage policy that pads coordinates with zeros up to the next power of
+     * two, so that a coordinate tuple fills an aligned SIMD register. The
+     * padding lanes are ignored by comparison and input/output.
+     */
+    struct padded_storage
+    {
+    };
+
+    namespace detail
+    {
+        inline constexpr
+        unsigned next_power_of_two(unsigned n) noexcept
+        {
+            return n <= 1 ? 1 : 2 * next_power_of_two((n + 1) / 2);
+        }
+    }
+
     /**
      * Kernel that uses builtin floating point type and standard library math.
      */
-    template<typename T, unsigned n>
+    template<typename T, unsigned n, typename Storage = packed_storage>
     struct standard_kernel
     {
         static_assert(std::is_floating_point<T>::value, "");
         static_assert(n >= 1, "");
+        static_assert(std::is_same<Storage, packed_storage>::value ||
+                      std::is_same<Storage, padded_storage>::value, "");
 
         /**
          * Aliased to T.
@@ -39,6 +66,15 @@ namespace geo
          */
         static constexpr unsigned dimension = n;
 
+        /**
+         * Number of scalars stored for a coordinate tuple. Set to n for
+         * packed_storage and to n rounded up to a power of two for
+         * padded_storage.
+         */
+        static constexpr unsigned storage_dimension =
+            std::is_same<Storage, padded_storage>::value
+                ? detail::next_power_of_two(n) : n;
+
         /**
          * Calls std::sqrt(x).
          */
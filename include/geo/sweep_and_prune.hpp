@@ -0,0 +1,137 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Incremental sweep-and-prune broad phase.
+//
+
+#ifndef GEO_SWEEP_AND_PRUNE_HPP
+#define GEO_SWEEP_AND_PRUNE_HPP
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "box.hpp"
+#include "internal/aligned_allocator.hpp"
+
+namespace geo
+{
+    /**
+     * Broad phase collision detection over the bounding boxes of a set of
+     * moving shapes.
+     *
+     * The endpoints of the projections of the boxes onto one axis are kept
+     * sorted across calls to update(). Since shapes move little between
+     * frames, the endpoints are nearly sorted and insertion sort restores
+     * their order in close to linear time. A sweep over the endpoints then
+     * tests only the boxes whose projections overlap.
+     *
+     * Shapes are identified by their index in the range passed to update().
+     * The Shape type must have a bounding_box() function found by
+     * argument-dependent lookup, like box, sphere and ellipsoid. Passing the
+     * cached boxes of a shape_pool avoids recomputing them.
+     */
+    template<typename K>
+    struct sweep_and_prune
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type of bounding boxes.
+         */
+        using box_type = box<K>;
+
+        /**
+         * Type for indices of shapes.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Type of reported pairs.
+         */
+        using pair_type = std::pair<index_type, index_type>;
+
+        /**
+         * Dimension of the underlying Euclidean space.
+         */
+        static constexpr unsigned dimension = K::dimension;
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty broad phase sweeping along the first axis.
+         */
+        sweep_and_prune() = default;
+
+        /**
+         * Creates an empty broad phase sweeping along given axis. Choose the
+         * axis along which the shapes are spread the most.
+         */
+        explicit
+        sweep_and_prune(unsigned axis);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the number of shapes.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns the axis along which endpoints are sorted.
+         */
+        unsigned axis() const noexcept;
+
+        // Modifiers -----------------------------------------------------------
+
+        /**
+         * Replaces the shapes with the ones in given range, which typically
+         * are the same shapes as in the previous call at their new positions.
+         *
+         * Endpoints are re-sorted by insertion sort. If the number of shapes
+         * changes, they are sorted from scratch instead.
+         */
+        template<typename Iterator>
+        void update(Iterator first, Iterator last);
+
+        // Query ---------------------------------------------------------------
+
+        /**
+         * Writes every pair (i, j) with i < j of shapes whose bounding boxes
+         * intersect to out in unspecified order. Returns the end of the
+         * output range.
+         *
+         * Boxes touching at the boundary are reported. The pairs are
+         * candidates: test them with the intersects() function of the
+         * actual shapes to find the colliding ones.
+         */
+        template<typename OutputIterator>
+        OutputIterator overlapping_pairs(OutputIterator out) const;
+
+      private:
+        struct endpoint
+        {
+            scalar_type value;
+            std::size_t key;
+        };
+
+        static bool precedes(endpoint const& a, endpoint const& b) noexcept;
+
+        unsigned axis_ = 0;
+        std::vector<box_type, aligned_allocator<box_type>> boxes_;
+        std::vector<endpoint> endpoints_;
+    };
+}
+
+#include "sweep_and_prune.ipp"
+
+#endif
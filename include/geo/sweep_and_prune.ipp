@@ -0,0 +1,166 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "point.hpp"
+#include "sweep_and_prune.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    sweep_and_prune<K>::sweep_and_prune(unsigned axis)
+        : axis_ {axis}
+    {
+        GEO_ASSERT(axis < dimension);
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    std::size_t sweep_and_prune<K>::size() const noexcept
+    {
+        return boxes_.size();
+    }
+
+    template<typename K>
+    unsigned sweep_and_prune<K>::axis() const noexcept
+    {
+        return axis_;
+    }
+
+    // Modifiers ---------------------------------------------------------------
+
+    // The key of an endpoint is twice the index of its shape, plus one for
+    // the upper end of the interval.
+
+    template<typename K>
+    template<typename Iterator>
+    void sweep_and_prune<K>::update(Iterator first, Iterator last)
+    {
+        boxes_.clear();
+        for (; first != last; ++first) {
+            boxes_.push_back(bounding_box(*first));
+        }
+
+        std::size_t const count = boxes_.size();
+
+        if (endpoints_.size() != 2 * count) {
+            endpoints_.resize(2 * count);
+            for (std::size_t i = 0; i < count; ++i) {
+                endpoints_[2 * i] = endpoint {boxes_[i].lowest_vertex()[axis_], 2 * i};
+                endpoints_[2 * i + 1] = endpoint {boxes_[i].highest_vertex()[axis_], 2 * i + 1};
+            }
+            std::sort(endpoints_.begin(), endpoints_.end(), precedes);
+            return;
+        }
+
+        for (endpoint& e : endpoints_) {
+            box_type const& b = boxes_[e.key / 2];
+            e.value = (e.key & 1) ? b.highest_vertex()[axis_] : b.lowest_vertex()[axis_];
+        }
+
+        // Insertion sort, which takes time proportional to the number of
+        // endpoints plus the number of swaps, that is, of intervals whose
+        // ends crossed since the last update.
+        for (std::size_t i = 1; i < endpoints_.size(); ++i) {
+            endpoint const e = endpoints_[i];
+            std::size_t j = i;
+            for (; j > 0 && precedes(e, endpoints_[j - 1]); --j) {
+                endpoints_[j] = endpoints_[j - 1];
+            }
+            endpoints_[j] = e;
+        }
+    }
+
+    // Query -------------------------------------------------------------------
+
+    template<typename K>
+    template<typename OutputIterator>
+    OutputIterator sweep_and_prune<K>::overlapping_pairs(OutputIterator out) const
+    {
+        // Shapes whose intervals contain the sweep position, with their
+        // bounds stored axis by axis so that a new shape is tested against
+        // all of them in streaming passes. Intervals along the sweep axis
+        // are known to overlap and are not tested again. A shape is removed
+        // by moving the last one to its slot.
+        std::vector<index_type> active;
+        std::vector<scalar_type> lows[dimension];
+        std::vector<scalar_type> highs[dimension];
+        std::vector<std::size_t> slots(boxes_.size());
+        std::vector<unsigned char> overlaps;
+
+        for (endpoint const& e : endpoints_) {
+            index_type const i = e.key / 2;
+
+            if (e.key & 1) {
+                std::size_t const slot = slots[i];
+                index_type const moved = active.back();
+                active[slot] = moved;
+                slots[moved] = slot;
+                active.pop_back();
+                for (unsigned axis = 0; axis < dimension; ++axis) {
+                    lows[axis][slot] = lows[axis].back();
+                    highs[axis][slot] = highs[axis].back();
+                    lows[axis].pop_back();
+                    highs[axis].pop_back();
+                }
+                continue;
+            }
+
+            std::size_t const count = active.size();
+            point<K> const low = boxes_[i].lowest_vertex();
+            point<K> const high = boxes_[i].highest_vertex();
+
+            overlaps.assign(count, 1);
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                if (axis == axis_) {
+                    continue;
+                }
+                scalar_type const* const active_lows = lows[axis].data();
+                scalar_type const* const active_highs = highs[axis].data();
+                scalar_type const axis_low = low[axis];
+                scalar_type const axis_high = high[axis];
+                unsigned char* const flags = overlaps.data();
+                for (std::size_t k = 0; k < count; ++k) {
+                    flags[k] &= static_cast<unsigned char>(
+                        (active_lows[k] <= axis_high) & (axis_low <= active_highs[k])
+                    );
+                }
+            }
+
+            for (std::size_t k = 0; k < count; ++k) {
+                if (overlaps[k]) {
+                    index_type const j = active[k];
+                    *out++ = i < j ? pair_type {i, j} : pair_type {j, i};
+                }
+            }
+
+            slots[i] = count;
+            active.push_back(i);
+            for (unsigned axis = 0; axis < dimension; ++axis) {
+                lows[axis].push_back(low[axis]);
+                highs[axis].push_back(high[axis]);
+            }
+        }
+
+        return out;
+    }
+
+    // Internals ---------------------------------------------------------------
+
+    // Lower ends go before upper ends at the same position, so that touching
+    // intervals overlap.
+    template<typename K>
+    bool sweep_and_prune<K>::precedes(endpoint const& a, endpoint const& b) noexcept
+    {
+        return a.value < b.value || (a.value == b.value && (a.key & 1) < (b.key & 1));
+    }
+}
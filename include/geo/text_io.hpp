@@ -0,0 +1,72 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Fast text input/output of points.
+//
+
+#ifndef GEO_TEXT_IO_HPP
+#define GEO_TEXT_IO_HPP
+
+#include <cstddef>
+#include <cstdlib>
+#include <istream>
+#include <ostream>
+#include <vector>
+
+#include "point.hpp"
+
+#if !defined(GEO_DISABLE_STRTOD_L) && \
+    ((defined(__GLIBC__) && defined(_GNU_SOURCE)) || defined(__APPLE__))
+# define GEO_HAS_STRTOD_L 1
+#else
+# define GEO_HAS_STRTOD_L 0
+#endif
+
+namespace geo
+{
+    /**
+     * Parses whitespace-separated coordinates in [first, last) and appends
+     * the points to out. Coordinates may also be separated by
+     * point<K>::delimiter, which operator<< writes.
+     *
+     * Numbers are parsed without iostream or the current locale: the decimal
+     * separator is always a period. Floating-point coordinates are decimal
+     * numbers with an optional exponent, or inf, infinity and nan in any
+     * case. Returns false if a token is not a number or the number of
+     * coordinates is not a multiple of the dimension; the points parsed
+     * before the error are kept in out.
+     */
+    template<typename K, typename Allocator>
+    bool parse_text(char const* first, char const* last,
+                    std::vector<point<K>, Allocator>& out);
+
+    /**
+     * Reads all points from in in the format accepted by parse_text() and
+     * appends them to out.
+     *
+     * The stream is consumed in chunks of fixed size, so memory use does not
+     * grow with the size of the input beyond the points themselves. Sets
+     * failbit of in on parse error. Returns in.
+     */
+    template<typename K, typename Allocator>
+    std::istream& read_text(std::istream& in, std::vector<point<K>, Allocator>& out);
+
+    /**
+     * Writes points in [first, last) to out, one point per line with
+     * coordinates separated by point<K>::delimiter.
+     *
+     * Each floating-point coordinate is written with digits10 significant
+     * digits, or up to max_digits10 if needed to parse back to the same
+     * value, with trailing zeros removed. So 0.1 is written as 0.1 and any
+     * value round-trips exactly. The decimal separator is always a period.
+     * Output is formatted into a fixed-size buffer that is flushed to out in
+     * chunks. Returns out.
+     */
+    template<typename K, typename Iterator>
+    std::ostream& write_text(std::ostream& out, Iterator first, Iterator last);
+}
+
+#include "text_io.ipp"
+
+#endif
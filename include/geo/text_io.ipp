@@ -0,0 +1,640 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <ios>
+#include <istream>
+#include <limits>
+#include <locale>
+#include <ostream>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#if GEO_HAS_STRTOD_L
+# include <locale.h>
+# include <stdlib.h>
+# if defined(__APPLE__)
+#  include <xlocale.h>
+# endif
+#endif
+
+#include "point.hpp"
+#include "text_io.hpp"
+
+namespace geo
+{
+    namespace detail
+    {
+        // Size of chunks read from or written to streams.
+        constexpr std::size_t text_chunk_size = std::size_t(1) << 20;
+
+        // Upper bound of the length of a formatted scalar.
+        constexpr std::size_t text_scalar_width = 64;
+
+        inline
+        bool is_text_separator(char c, char delimiter) noexcept
+        {
+            return c == delimiter || c == ' ' || c == '\n' || c == '\t' ||
+                   c == '\r' || c == '\v' || c == '\f';
+        }
+
+        // Decimal number as sign * mantissa * 10^exponent. exact is false if
+        // the mantissa has more digits than fit in 64 bits.
+        struct decimal_number
+        {
+            std::uint64_t mantissa = 0;
+            int exponent = 0;
+            bool negative = false;
+            bool exact = true;
+        };
+
+        // Scans a token of the form [+-]digits[.digits][(e|E)[+-]digits].
+        // Returns false for anything else, including inf and nan.
+        inline
+        bool scan_decimal(char const* first, char const* last, decimal_number& num) noexcept
+        {
+            constexpr std::uint64_t mantissa_limit = 1000000000000000000; // 10^18
+
+            if (first != last && (*first == '+' || *first == '-')) {
+                num.negative = *first == '-';
+                ++first;
+            }
+
+            bool any_digit = false;
+            bool seen_point = false;
+            for (; first != last; ++first) {
+                char const c = *first;
+                if (c >= '0' && c <= '9') {
+                    any_digit = true;
+                    if (num.mantissa < mantissa_limit) {
+                        num.mantissa = num.mantissa * 10 + static_cast<unsigned>(c - '0');
+                        num.exponent -= seen_point;
+                    } else {
+                        num.exact &= c == '0';
+                        num.exponent += !seen_point;
+                    }
+                } else if (c == '.' && !seen_point) {
+                    seen_point = true;
+                } else {
+                    break;
+                }
+            }
+            if (!any_digit) {
+                return false;
+            }
+
+            if (first != last && (*first == 'e' || *first == 'E')) {
+                ++first;
+                bool negative_exponent = false;
+                if (first != last && (*first == '+' || *first == '-')) {
+                    negative_exponent = *first == '-';
+                    ++first;
+                }
+                if (first == last) {
+                    return false;
+                }
+                int exponent = 0;
+                for (; first != last && *first >= '0' && *first <= '9'; ++first) {
+                    // Saturate; such exponents over- or underflow anyway.
+                    exponent = std::min(exponent * 10 + (*first - '0'), 100000);
+                }
+                num.exponent += negative_exponent ? -exponent : exponent;
+            }
+
+            return first == last;
+        }
+
+        // Clinger's fast path: if the mantissa and the power of ten are both
+        // exactly representable, one multiplication or division gives the
+        // correctly rounded result.
+
+        inline
+        bool fast_decimal_to_scalar(decimal_number const& num, double& value) noexcept
+        {
+            static constexpr double powers[] = {
+                1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+                1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+            };
+            if (!num.exact || num.mantissa > (std::uint64_t(1) << 53) ||
+                num.exponent < -22 || num.exponent > 22) {
+                return false;
+            }
+            double const m = static_cast<double>(num.mantissa);
+            value = num.exponent < 0 ? m / powers[-num.exponent] : m * powers[num.exponent];
+            value = num.negative ? -value : value;
+            return true;
+        }
+
+        inline
+        bool fast_decimal_to_scalar(decimal_number const& num, float& value) noexcept
+        {
+            static constexpr float powers[] = {
+                1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f, 1e7f, 1e8f, 1e9f, 1e10f
+            };
+            if (!num.exact || num.mantissa > (std::uint64_t(1) << 24) ||
+                num.exponent < -10 || num.exponent > 10) {
+                return false;
+            }
+            float const m = static_cast<float>(num.mantissa);
+            value = num.exponent < 0 ? m / powers[-num.exponent] : m * powers[num.exponent];
+            value = num.negative ? -value : value;
+            return true;
+        }
+
+        inline
+        bool fast_decimal_to_scalar(decimal_number const&, long double&) noexcept
+        {
+            return false;
+        }
+
+        // Recognizes inf, infinity and nan in any case with an optional sign,
+        // as written by write_text() for special values.
+        template<typename T>
+        bool parse_special_scalar(char const* first, char const* last, T& value) noexcept
+        {
+            bool negative = false;
+            if (first != last && (*first == '+' || *first == '-')) {
+                negative = *first == '-';
+                ++first;
+            }
+
+            auto const equals = [&](char const* word) {
+                char const* cursor = first;
+                for (; *word && cursor != last; ++word, ++cursor) {
+                    if ((*cursor | 0x20) != *word) {
+                        return false;
+                    }
+                }
+                return !*word && cursor == last;
+            };
+
+            if (equals("inf") || equals("infinity")) {
+                value = std::numeric_limits<T>::infinity();
+            } else if (equals("nan")) {
+                value = std::numeric_limits<T>::quiet_NaN();
+            } else {
+                return false;
+            }
+            value = negative ? -value : value;
+            return true;
+        }
+
+#if GEO_HAS_STRTOD_L
+
+        // The C locale, created once and shared by all threads.
+        inline
+        locale_t classic_c_locale() noexcept
+        {
+            static locale_t const locale = ::newlocale(LC_ALL_MASK, "C", locale_t(0));
+            return locale;
+        }
+
+        inline
+        void strto(char const* str, char** end, float& value)
+        {
+            value = ::strtof_l(str, end, classic_c_locale());
+        }
+
+        inline
+        void strto(char const* str, char** end, double& value)
+        {
+            value = ::strtod_l(str, end, classic_c_locale());
+        }
+
+        inline
+        void strto(char const* str, char** end, long double& value)
+        {
+            value = ::strtold_l(str, end, classic_c_locale());
+        }
+
+        // Slow path through strto*_l() in the C locale, so that the result
+        // does not depend on the current locale. The token has been checked
+        // by scan_decimal() and only needs a terminating null character.
+        template<typename T>
+        bool slow_parse_scalar(char const* first, char const* last, bool, T& value)
+        {
+            auto const length = static_cast<std::size_t>(last - first);
+            char small[text_scalar_width];
+            std::string large;
+            char* token = small;
+            if (length >= sizeof small) {
+                large.assign(first, last);
+                token = &large[0];
+            } else {
+                std::copy(first, last, small);
+                small[length] = '\0';
+            }
+
+            char* end;
+            strto(token, &end, value);
+            return end == token + length;
+        }
+
+#else
+
+        // Per-thread formatting state for slow_parse_scalar(). Its locale is
+        // the classic one with a numeric parser of character ranges added.
+        struct classic_number_format
+        {
+            using facet_type = std::num_get<char, char const*>;
+
+            classic_number_format()
+                : format {nullptr}
+            {
+                format.imbue(std::locale {std::locale::classic(), new facet_type});
+            }
+
+            static classic_number_format& instance()
+            {
+                thread_local classic_number_format instance;
+                return instance;
+            }
+
+            std::ios format;
+        };
+
+        // Slow path through std::num_get of the classic locale, which rounds
+        // correctly like strto*() but does not depend on the current locale.
+        // The token has been checked by scan_decimal(), so failure means the
+        // magnitude is out of range, and the result is infinity as with
+        // strto*().
+        template<typename T>
+        bool slow_parse_scalar(char const* first, char const* last,
+                               bool negative, T& value)
+        {
+            using facet_type = classic_number_format::facet_type;
+
+            std::ios& format = classic_number_format::instance().format;
+            facet_type const& facet = std::use_facet<facet_type>(format.getloc());
+
+            std::ios::iostate state = std::ios::goodbit;
+            T result;
+            if (facet.get(first, last, format, state, result) != last) {
+                return false;
+            }
+            if (state & std::ios::failbit) {
+                result = std::numeric_limits<T>::infinity();
+                result = negative ? -result : result;
+            }
+            value = result;
+            return true;
+        }
+
+#endif
+
+        // Floating-point scalars: decimal numbers with optional exponent and
+        // special values. Other tokens, like hexadecimal numbers or numbers
+        // with a comma as the decimal separator, are rejected.
+        template<typename T>
+        bool parse_scalar(char const* first, char const* last, T& value, std::false_type)
+        {
+            decimal_number num;
+            if (!scan_decimal(first, last, num)) {
+                return parse_special_scalar(first, last, value);
+            }
+            if (fast_decimal_to_scalar(num, value)) {
+                return true;
+            }
+            return slow_parse_scalar(first, last, num.negative, value);
+        }
+
+        // Integral scalars: optional sign and decimal digits.
+        template<typename T>
+        bool parse_scalar(char const* first, char const* last, T& value, std::true_type)
+        {
+            using unsigned_type = typename std::make_unsigned<T>::type;
+
+            bool negative = false;
+            if (first != last && (*first == '+' || *first == '-')) {
+                negative = *first == '-';
+                ++first;
+            }
+            if (first == last || (negative && !std::is_signed<T>::value)) {
+                return false;
+            }
+
+            unsigned_type const limit = negative
+                ? unsigned_type(unsigned_type(std::numeric_limits<T>::max()) + 1)
+                : unsigned_type(std::numeric_limits<T>::max());
+            unsigned_type magnitude = 0;
+            for (; first != last; ++first) {
+                if (*first < '0' || *first > '9') {
+                    return false;
+                }
+                auto const digit = static_cast<unsigned_type>(*first - '0');
+                if (magnitude > (limit - digit) / 10) {
+                    return false;
+                }
+                magnitude = static_cast<unsigned_type>(magnitude * 10 + digit);
+            }
+            value = negative ? static_cast<T>(0 - magnitude) : static_cast<T>(magnitude);
+            return true;
+        }
+
+        template<typename T>
+        bool parse_scalar(char const* first, char const* last, T& value)
+        {
+            return parse_scalar(first, last, value, std::is_integral<T>{});
+        }
+
+        // Incremental parser keeping a partially parsed point across chunks.
+        template<typename K, typename Allocator>
+        struct text_parser
+        {
+            std::vector<point<K>, Allocator>& out;
+            point<K> current {};
+            unsigned axis = 0;
+
+            // Parses one token. Returns false on error.
+            bool token(char const* first, char const* last)
+            {
+                if (!parse_scalar(first, last, current[axis])) {
+                    return false;
+                }
+                if (++axis == K::dimension) {
+                    out.push_back(current);
+                    axis = 0;
+                }
+                return true;
+            }
+
+            // Parses all tokens in [first, last) that are followed by a
+            // separator. Returns the start of the trailing incomplete token,
+            // or nullptr on error.
+            char const* feed(char const* first, char const* last)
+            {
+                char const delimiter = point<K>::delimiter;
+                for (;;) {
+                    while (first != last && is_text_separator(*first, delimiter)) {
+                        ++first;
+                    }
+                    char const* end = first;
+                    while (end != last && !is_text_separator(*end, delimiter)) {
+                        ++end;
+                    }
+                    if (end == last) {
+                        return first;
+                    }
+                    if (!token(first, end)) {
+                        return nullptr;
+                    }
+                    first = end;
+                }
+            }
+
+            // Parses the trailing token at the end of input. Returns false on
+            // error or if the last point is incomplete.
+            bool finish(char const* first, char const* last)
+            {
+                if (first != last && !token(first, last)) {
+                    return false;
+                }
+                return axis == 0;
+            }
+        };
+
+        // Formats value into out, which must have text_scalar_width bytes.
+        // Returns the end of the formatted text.
+        template<typename T>
+        char* format_scalar(char* out, T value, std::true_type)
+        {
+            using wide_type = typename std::conditional<
+                std::is_signed<T>::value, long long, unsigned long long
+            >::type;
+            int const length = std::snprintf(
+                out, text_scalar_width, std::is_signed<T>::value ? "%lld" : "%llu",
+                static_cast<wide_type>(value)
+            );
+            return out + length;
+        }
+
+        inline
+        int format_exponential(char* out, int precision, double value)
+        {
+            return std::snprintf(out, text_scalar_width, "%.*e", precision, value);
+        }
+
+        inline
+        int format_exponential(char* out, int precision, long double value)
+        {
+            return std::snprintf(out, text_scalar_width, "%.*Le", precision, value);
+        }
+
+        // Writes sign * 0.d1d2...dn * 10^(exponent + 1) in the style of %g
+        // with trailing zeros removed. Returns the end of the text.
+        inline
+        char* write_decimal(char* out, bool negative, char const* digits,
+                            int count, int exponent)
+        {
+            while (count > 1 && digits[count - 1] == '0') {
+                --count;
+            }
+            if (negative) {
+                *out++ = '-';
+            }
+
+            int const precision = std::max(count, 1);
+            if (exponent < -4 || exponent >= std::max(precision, 6)) {
+                *out++ = digits[0];
+                if (count > 1) {
+                    *out++ = '.';
+                    out = std::copy(digits + 1, digits + count, out);
+                }
+                *out++ = 'e';
+                *out++ = exponent < 0 ? '-' : '+';
+                int magnitude = exponent < 0 ? -exponent : exponent;
+                char reversed[8];
+                int length = 0;
+                do {
+                    reversed[length++] = static_cast<char>('0' + magnitude % 10);
+                    magnitude /= 10;
+                } while (magnitude != 0 || length < 2);
+                while (length > 0) {
+                    *out++ = reversed[--length];
+                }
+            } else if (exponent < 0) {
+                *out++ = '0';
+                *out++ = '.';
+                out = std::fill_n(out, -exponent - 1, '0');
+                out = std::copy(digits, digits + count, out);
+            } else {
+                int const integral = exponent + 1;
+                for (int i = 0; i < integral; ++i) {
+                    *out++ = i < count ? digits[i] : '0';
+                }
+                if (count > integral) {
+                    *out++ = '.';
+                    out = std::copy(digits + integral, digits + count, out);
+                }
+            }
+            return out;
+        }
+
+        // Formats value with the fewest significant digits, not less than
+        // digits10, that parse back to the same value. The digits of
+        // max_digits10 precision, which always round-trip, are produced by a
+        // single snprintf() call; shorter candidates are obtained by rounding
+        // them and are accepted only if they parse back exactly.
+        template<typename T>
+        char* format_scalar(char* out, T value, std::false_type)
+        {
+            using format_type = typename std::conditional<
+                std::is_same<T, long double>::value, long double, double
+            >::type;
+
+            constexpr int max_digits = std::numeric_limits<T>::max_digits10;
+
+            if (!(value - value == value - value)) {
+                // Infinity or NaN.
+                int const length = std::snprintf(out, text_scalar_width, "%g",
+                                                 static_cast<double>(value));
+                return out + length;
+            }
+
+            char text[text_scalar_width];
+            format_exponential(text, max_digits - 1, static_cast<format_type>(value));
+
+            // Text is [-]d.ddd...e(+|-)xx in any locale but for the decimal
+            // separator, which is skipped.
+            char const* cursor = text;
+            bool const negative = *cursor == '-';
+            cursor += negative;
+
+            char digits[max_digits];
+            int count = 0;
+            for (; *cursor != 'e'; ++cursor) {
+                if (*cursor >= '0' && *cursor <= '9' && count < max_digits) {
+                    digits[count++] = *cursor;
+                }
+            }
+            ++cursor;
+            bool const negative_exponent = *cursor == '-';
+            int exponent = 0;
+            for (++cursor; *cursor; ++cursor) {
+                exponent = exponent * 10 + (*cursor - '0');
+            }
+            exponent = negative_exponent ? -exponent : exponent;
+
+            for (int precision = std::numeric_limits<T>::digits10;
+                 precision < max_digits;
+                 ++precision) {
+                char rounded[max_digits];
+                std::copy(digits, digits + precision, rounded);
+                int rounded_exponent = exponent;
+
+                if (digits[precision] >= '5') {
+                    int i = precision - 1;
+                    for (; i >= 0 && rounded[i] == '9'; --i) {
+                        rounded[i] = '0';
+                    }
+                    if (i >= 0) {
+                        rounded[i]++;
+                    } else {
+                        rounded[0] = '1';
+                        rounded_exponent++;
+                    }
+                }
+
+                char* const end = write_decimal(out, negative, rounded, precision,
+                                                rounded_exponent);
+                T parsed;
+                if (parse_scalar(out, end, parsed) && parsed == value) {
+                    return end;
+                }
+            }
+
+            return write_decimal(out, negative, digits, count, exponent);
+        }
+
+        template<typename T>
+        char* format_scalar(char* out, T value)
+        {
+            return format_scalar(out, value, std::is_integral<T>{});
+        }
+    }
+
+    template<typename K, typename Allocator>
+    bool parse_text(char const* first, char const* last,
+                    std::vector<point<K>, Allocator>& out)
+    {
+        detail::text_parser<K, Allocator> parser {out};
+        char const* const rest = parser.feed(first, last);
+        return rest && parser.finish(rest, last);
+    }
+
+    template<typename K, typename Allocator>
+    std::istream& read_text(std::istream& in, std::vector<point<K>, Allocator>& out)
+    {
+        detail::text_parser<K, Allocator> parser {out};
+        std::vector<char> buffer(detail::text_chunk_size);
+        std::size_t carry = 0;
+
+        for (;;) {
+            // A token longer than the buffer is rare; grow to hold it.
+            if (carry == buffer.size()) {
+                buffer.resize(2 * buffer.size());
+            }
+
+            in.read(buffer.data() + carry, static_cast<std::streamsize>(buffer.size() - carry));
+            auto const count = static_cast<std::size_t>(in.gcount());
+            char const* const begin = buffer.data();
+            char const* const end = begin + carry + count;
+
+            if (in.eof()) {
+                // Hitting the end of stream sets failbit as well, which does
+                // not mean an error here.
+                in.clear(in.rdstate() & ~std::ios::failbit);
+                char const* const rest = parser.feed(begin, end);
+                if (!rest || !parser.finish(rest, end)) {
+                    in.setstate(std::ios::failbit);
+                }
+                return in;
+            }
+            if (!in) {
+                return in;
+            }
+
+            char const* const rest = parser.feed(begin, end);
+            if (!rest) {
+                in.setstate(std::ios::failbit);
+                return in;
+            }
+            carry = static_cast<std::size_t>(end - rest);
+            std::copy(rest, end, buffer.data());
+        }
+    }
+
+    template<typename K, typename Iterator>
+    std::ostream& write_text(std::ostream& out, Iterator first, Iterator last)
+    {
+        constexpr std::size_t point_width =
+            K::dimension * (detail::text_scalar_width + 1) + 1;
+
+        std::vector<char> buffer(std::max(detail::text_chunk_size, point_width));
+        char* const begin = buffer.data();
+        char* const limit = begin + buffer.size() - point_width;
+        char* cursor = begin;
+
+        for (; first != last && out; ++first) {
+            point<K> const p = *first;
+            for (unsigned i = 0; i < K::dimension; ++i) {
+                if (i != 0) {
+                    *cursor++ = point<K>::delimiter;
+                }
+                cursor = detail::format_scalar(cursor, p[i]);
+            }
+            *cursor++ = '\n';
+
+            if (cursor > limit) {
+                out.write(begin, cursor - begin);
+                cursor = begin;
+            }
+        }
+        out.write(begin, cursor - begin);
+        return out;
+    }
+}
@@ -39,6 +39,12 @@ namespace geo
          */
         using scalar_type = typename K::scalar;
 
+        /**
+         * Type for distance and inner products, which may be wider than
+         * scalar_type.
+         */
+        using metric_type = typename K::metric;
+
         /**
          * Type of iterator for accessing components by mutable references.
          */
@@ -92,11 +98,12 @@ namespace geo
      *
      * This function computes the squared root of squared_length(v) using
      * K::sqrt() function. So compilation would fail if the kernel does not
-     * provide sqrt() function.
+     * provide sqrt() function. The result has the type returned by
+     * K::sqrt(), which is usually K::metric.
      */
     template<typename K>
     constexpr
-    typename K::metric norm(vector<K> const& v) noexcept;
+    detail::length_type_of<K> norm(vector<K> const& v) noexcept;
 
     /**
      * Normalizes a vector.
@@ -21,9 +21,16 @@ namespace geo
     typename K::metric inner_product(vector<K> const& u,
                                      vector<K> const& v) noexcept
     {
-        typename K::scalar sum = 0;
-        for (unsigned i = 0; i < K::dimension; ++i) {
-            sum += u[i] * v[i];
+        // Padding lanes are zero and do not change the sum. Products are
+        // accumulated in the metric type, which may be wider than the
+        // scalar type.
+        using metric_type = typename K::metric;
+
+        typename K::scalar const* const u_lanes = u.data();
+        typename K::scalar const* const v_lanes = v.data();
+        metric_type sum = 0;
+        for (unsigned i = 0; i < vector<K>::mixin::storage_dimension; ++i) {
+            sum += metric_type(u_lanes[i]) * metric_type(v_lanes[i]);
         }
         return sum;
     }
@@ -37,7 +44,7 @@ namespace geo
 
     template<typename K>
     constexpr
-    typename K::metric norm(vector<K> const& v) noexcept
+    detail::length_type_of<K> norm(vector<K> const& v) noexcept
     {
         return K::sqrt(squared_norm(v));
     }
@@ -46,6 +53,6 @@ namespace geo
     constexpr
     vector<K> normalize(vector<K> const& v)
     {
-        return v / norm(v);
+        return v / static_cast<typename K::scalar>(norm(v));
     }
 }
@@ -0,0 +1,167 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+//
+// Verlet neighbor list with lazy rebuild.
+//
+
+#ifndef GEO_VERLET_LIST_HPP
+#define GEO_VERLET_LIST_HPP
+
+#include <cstddef>
+#include <vector>
+
+#include "point.hpp"
+
+namespace geo
+{
+    /**
+     * Neighbor list of points within cutoff + skin of each other.
+     *
+     * Pairs are stored once, under the smaller index, in compressed row
+     * layout: the neighbors of point i are the contiguous range
+     * neighbors(i) of indices greater than i, in ascending order.
+     *
+     * The list stays valid, in the sense that it contains every pair within
+     * cutoff, as long as no point moves farther than skin / 2 from its
+     * position at the last build. update() checks this condition against
+     * saved positions and rebuilds the list only when it is violated, so a
+     * time-stepping loop can call update() every step.
+     */
+    template<typename K>
+    struct verlet_list
+    {
+        /**
+         * Alias to the template parameter K.
+         */
+        using kernel = K;
+
+        /**
+         * Type for scalars of the underlying Euclidean space.
+         */
+        using scalar_type = typename K::scalar;
+
+        /**
+         * Type for distance measured in the underlying Euclidean space.
+         */
+        using metric_type = typename K::metric;
+
+        /**
+         * Type for points in the underlying Euclidean space.
+         */
+        using point_type = point<K>;
+
+        /**
+         * Type for indices of points.
+         */
+        using index_type = std::size_t;
+
+        /**
+         * Contiguous range of neighbor indices.
+         */
+        struct neighbor_range
+        {
+            index_type const* first;
+            index_type const* last;
+
+            index_type const* begin() const noexcept
+            {
+                return first;
+            }
+
+            index_type const* end() const noexcept
+            {
+                return last;
+            }
+
+            std::size_t size() const noexcept
+            {
+                return static_cast<std::size_t>(last - first);
+            }
+        };
+
+        // Creation ------------------------------------------------------------
+
+        /**
+         * Creates an empty list. Assertion fails if cutoff or skin is
+         * negative.
+         */
+        verlet_list(metric_type cutoff, metric_type skin);
+
+        // Attributes ----------------------------------------------------------
+
+        /**
+         * Returns the interaction cutoff distance.
+         */
+        metric_type cutoff() const noexcept;
+
+        /**
+         * Returns the skin distance.
+         */
+        metric_type skin() const noexcept;
+
+        /**
+         * Returns the number of points in the last build.
+         */
+        std::size_t size() const noexcept;
+
+        /**
+         * Returns the number of stored pairs.
+         */
+        std::size_t pair_count() const noexcept;
+
+        /**
+         * Returns the number of builds done so far.
+         */
+        std::size_t build_count() const noexcept;
+
+        // Construction --------------------------------------------------------
+
+        /**
+         * Returns true if the list is not valid for the points in given
+         * range: the number of points has changed or some point has moved
+         * more than skin / 2 since the last build.
+         */
+        template<typename Iterator>
+        bool needs_rebuild(Iterator first, Iterator last) const;
+
+        /**
+         * Rebuilds the list from the points in given range if needed.
+         * Returns true if the list is rebuilt.
+         */
+        template<typename Iterator>
+        bool update(Iterator first, Iterator last);
+
+        /**
+         * Rebuilds the list from the points in given range unconditionally.
+         */
+        template<typename Iterator>
+        void rebuild(Iterator first, Iterator last);
+
+        // Query ---------------------------------------------------------------
+
+        /**
+         * Returns the indices of neighbors of point i that are greater than
+         * i. Assertion fails if i is out of range.
+         */
+        neighbor_range neighbors(index_type i) const noexcept;
+
+        /**
+         * Calls fn(i, j) for every stored pair with i < j.
+         */
+        template<typename Fn>
+        void for_each_pair(Fn fn) const;
+
+      private:
+        metric_type cutoff_;
+        metric_type skin_;
+        std::size_t build_count_ = 0;
+        std::vector<std::size_t> row_begin_;
+        std::vector<index_type> neighbors_;
+        std::vector<point_type> positions_;
+    };
+}
+
+#include "verlet_list.ipp"
+
+#endif
@@ -0,0 +1,172 @@
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#include "assert.hpp"
+#include "box.hpp"
+#include "cell_list.hpp"
+#include "point.hpp"
+#include "verlet_list.hpp"
+
+namespace geo
+{
+    // Creation ----------------------------------------------------------------
+
+    template<typename K>
+    verlet_list<K>::verlet_list(metric_type cutoff, metric_type skin)
+        : cutoff_ {cutoff}
+        , skin_ {skin}
+    {
+        GEO_ASSERT(cutoff >= 0);
+        GEO_ASSERT(skin >= 0);
+    }
+
+    // Attributes --------------------------------------------------------------
+
+    template<typename K>
+    auto verlet_list<K>::cutoff() const noexcept -> metric_type
+    {
+        return cutoff_;
+    }
+
+    template<typename K>
+    auto verlet_list<K>::skin() const noexcept -> metric_type
+    {
+        return skin_;
+    }
+
+    template<typename K>
+    std::size_t verlet_list<K>::size() const noexcept
+    {
+        return positions_.size();
+    }
+
+    template<typename K>
+    std::size_t verlet_list<K>::pair_count() const noexcept
+    {
+        return neighbors_.size();
+    }
+
+    template<typename K>
+    std::size_t verlet_list<K>::build_count() const noexcept
+    {
+        return build_count_;
+    }
+
+    // Construction ------------------------------------------------------------
+
+    template<typename K>
+    template<typename Iterator>
+    bool verlet_list<K>::needs_rebuild(Iterator first, Iterator last) const
+    {
+        if (build_count_ == 0) {
+            return true;
+        }
+
+        metric_type const half_skin = skin_ / 2;
+        metric_type const threshold = half_skin * half_skin;
+
+        std::size_t idx = 0;
+        for (; first != last; ++first, ++idx) {
+            if (idx == positions_.size()) {
+                return true;
+            }
+            if (squared_distance(point_type(*first), positions_[idx]) > threshold) {
+                return true;
+            }
+        }
+        return idx != positions_.size();
+    }
+
+    template<typename K>
+    template<typename Iterator>
+    bool verlet_list<K>::update(Iterator first, Iterator last)
+    {
+        if (!needs_rebuild(first, last)) {
+            return false;
+        }
+        rebuild(first, last);
+        return true;
+    }
+
+    template<typename K>
+    template<typename Iterator>
+    void verlet_list<K>::rebuild(Iterator first, Iterator last)
+    {
+        positions_.assign(first, last);
+        build_count_++;
+
+        std::size_t const count = positions_.size();
+        row_begin_.assign(count + 1, 0);
+        neighbors_.clear();
+
+        if (count == 0) {
+            return;
+        }
+
+        box<K> domain {positions_.front(), positions_.front()};
+        for (point_type const& p : positions_) {
+            domain = merge(domain, box<K> {p, p});
+        }
+
+        metric_type const reach = cutoff_ + skin_;
+        std::vector<std::pair<index_type, index_type>> pairs;
+
+        // Zero reach would give zero cell width, so only coincident points
+        // are searched with a unit-width grid in that case. The cell list
+        // widens its cells to keep the grid within O(count) cells, so a far
+        // outlier stretching the domain does not allocate a huge grid.
+        cell_list<K> const cells {
+            positions_.begin(), positions_.end(),
+            domain, reach > 0 ? reach : metric_type(1)
+        };
+        cells.for_each_pair_within(reach, [&](index_type i, index_type j, metric_type) {
+            pairs.emplace_back(std::min(i, j), std::max(i, j));
+        });
+
+        // Counting sort of pairs into rows, then sort each row.
+        for (auto const& pair : pairs) {
+            row_begin_[pair.first + 1]++;
+        }
+        std::partial_sum(row_begin_.begin(), row_begin_.end(), row_begin_.begin());
+
+        std::vector<std::size_t> cursor(row_begin_.begin(), row_begin_.end() - 1);
+        neighbors_.resize(pairs.size());
+        for (auto const& pair : pairs) {
+            neighbors_[cursor[pair.first]++] = pair.second;
+        }
+
+        for (std::size_t i = 0; i < count; ++i) {
+            auto const row = neighbors_.begin();
+            std::sort(row + static_cast<std::ptrdiff_t>(row_begin_[i]),
+                      row + static_cast<std::ptrdiff_t>(row_begin_[i + 1]));
+        }
+    }
+
+    // Query -------------------------------------------------------------------
+
+    template<typename K>
+    auto verlet_list<K>::neighbors(index_type i) const noexcept -> neighbor_range
+    {
+        GEO_ASSERT(i < size());
+
+        index_type const* const data = neighbors_.data();
+        return {data + row_begin_[i], data + row_begin_[i + 1]};
+    }
+
+    template<typename K>
+    template<typename Fn>
+    void verlet_list<K>::for_each_pair(Fn fn) const
+    {
+        for (std::size_t i = 0; i < size(); ++i) {
+            for (std::size_t k = row_begin_[i]; k < row_begin_[i + 1]; ++k) {
+                fn(i, neighbors_[k]);
+            }
+        }
+    }
+}
@@ -36,6 +36,26 @@ double compute_potential_energy(std::vector<point_t> const& points)
     return energy;
 }
 
+// geo::point_soa
+double compute_potential_energy(geo::point_soa<kernel> const& points)
+{
+    index_t const n_points = points.size();
+    double const* const xs = points.axis(0);
+    double const* const ys = points.axis(1);
+    double const* const zs = points.axis(2);
+    double energy = 0;
+    for (index_t i = 0; i < n_points; ++i) {
+        for (index_t j = i + 1; j < n_points; ++j) {
+            double const dx = xs[i] - xs[j];
+            double const dy = ys[i] - ys[j];
+            double const dz = zs[i] - zs[j];
+            double const r2 = dx * dx + dy * dy + dz * dz;
+            energy += evaluate_lennard_jones_potential(r2);
+        }
+    }
+    return energy;
+}
+
 // Raw array
 template<index_t N>
 double compute_potential_energy(double const(& points)[N][3])
@@ -53,6 +73,21 @@ double compute_potential_energy(double const(& points)[N][3])
     return energy;
 }
 
+// geo::pair_engine
+struct engine_input
+{
+    std::vector<point_t> const& points;
+};
+
+double compute_potential_energy(engine_input const& input)
+{
+    geo::lennard_jones_potential<double> potential;
+    potential.epsilon = 0.25;
+    potential.sigma = 0.001;
+    geo::pair_engine<kernel, geo::lennard_jones_potential<double>> const engine{potential};
+    return engine.energy(geo::execution::par, input.points.begin(), input.points.end());
+}
+
 std::vector<point_t> generate_points(index_t n_points)
 {
     std::vector<point_t> points;
@@ -109,9 +144,17 @@ int main()
     double points_array[n_points][point_t::dimension];
     std::memcpy(points_array, points_vector.data(), sizeof(points_array));
 
+    geo::point_soa<kernel> const points_soa(points_vector.begin(), points_vector.end());
+
     std::cout << "vector<geo::point>\n";
     measure(points_vector, n_measures);
 
+    std::cout << "geo::point_soa\n";
+    measure(points_soa, n_measures);
+
     std::cout << "Raw array\n";
     measure(points_array, n_measures);
+
+    std::cout << "geo::pair_engine\n";
+    measure(engine_input{points_vector}, n_measures);
 }
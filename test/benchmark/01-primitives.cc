@@ -0,0 +1,640 @@
+// Microbenchmarks of geometric primitives for dimensions 2, 3, 4 and 8 and
+// for float and double scalars.
+//
+// Results are printed to stdout as JSON in the layout used by Google
+// Benchmark, so that runs built with different flags can be compared with
+// the same tools. Times are per item (per point or per query). Pass a
+// substring as the first argument to run matching benchmarks only. Define
+// GEO_BENCHMARK_FLAGS to record the compiler flags in the context, e.g.
+//
+//   c++ -std=c++14 -O2 -pthread -I include -DGEO_BENCHMARK_FLAGS='"-O2"'
+//       test/benchmark/01-primitives.cc
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <ctime>
+#include <iostream>
+#include <iterator>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <geo/all.hpp>
+
+#ifndef GEO_BENCHMARK_FLAGS
+# define GEO_BENCHMARK_FLAGS ""
+#endif
+
+namespace
+{
+    // Harness -----------------------------------------------------------------
+
+    // Makes the compiler assume that value is read, so that the computation of
+    // value is not optimized away. Works with GCC and Clang.
+    template<typename T>
+    void do_not_optimize(T const& value)
+    {
+        asm volatile("" : : "r,m"(value) : "memory");
+    }
+
+    struct benchmark_result
+    {
+        std::string name;
+        std::size_t iterations;
+        double real_time;
+        double cpu_time;
+        double items_per_second;
+    };
+
+    std::vector<benchmark_result> results;
+    std::string filter;
+
+    // Calls fn() repeatedly, where each call processes items items, and
+    // records the fastest of several timed runs. The number of calls per run
+    // is calibrated so that a run takes about min_run_time.
+    template<typename Fn>
+    void run_benchmark(std::string const& name, std::size_t items, Fn fn)
+    {
+        using clock = std::chrono::steady_clock;
+
+        constexpr double min_run_time = 0.02;
+        constexpr int repetitions = 5;
+
+        if (name.find(filter) == std::string::npos) {
+            return;
+        }
+
+        auto const time_run = [&](std::size_t iterations, double& cpu) {
+            std::clock_t const cpu_start = std::clock();
+            auto const start = clock::now();
+            for (std::size_t i = 0; i < iterations; ++i) {
+                fn();
+            }
+            auto const finish = clock::now();
+            cpu = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+            return std::chrono::duration<double>(finish - start).count();
+        };
+
+        std::size_t iterations = 1;
+        double cpu = 0;
+        while (time_run(iterations, cpu) < min_run_time && iterations < (std::size_t(1) << 30)) {
+            iterations *= 2;
+        }
+
+        double best_real = 1e300;
+        double best_cpu = 1e300;
+        for (int rep = 0; rep < repetitions; ++rep) {
+            double const real = time_run(iterations, cpu);
+            best_real = std::min(best_real, real);
+            best_cpu = std::min(best_cpu, cpu);
+        }
+
+        double const total_items = double(iterations) * double(items);
+        results.push_back(benchmark_result {
+            name,
+            iterations,
+            best_real / total_items * 1e9,
+            best_cpu / total_items * 1e9,
+            total_items / best_real
+        });
+        std::clog << name << ": " << results.back().real_time << " ns\n";
+    }
+
+    void print_json(std::ostream& out)
+    {
+#ifdef __FAST_MATH__
+        bool const fast_math = true;
+#else
+        bool const fast_math = false;
+#endif
+#ifdef __VERSION__
+        char const* const compiler = __VERSION__;
+#else
+        char const* const compiler = "unknown";
+#endif
+
+        out << "{\n";
+        out << "  \"context\": {\n";
+        out << "    \"compiler\": \"" << compiler << "\",\n";
+        out << "    \"flags\": \"" << GEO_BENCHMARK_FLAGS << "\",\n";
+        out << "    \"fast_math\": " << (fast_math ? "true" : "false") << ",\n";
+        out << "    \"num_cpus\": " << std::thread::hardware_concurrency() << "\n";
+        out << "  },\n";
+        out << "  \"benchmarks\": [";
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            benchmark_result const& r = results[i];
+            out << (i == 0 ? "\n" : ",\n");
+            out << "    {\n";
+            out << "      \"name\": \"" << r.name << "\",\n";
+            out << "      \"iterations\": " << r.iterations << ",\n";
+            out << "      \"real_time\": " << r.real_time << ",\n";
+            out << "      \"cpu_time\": " << r.cpu_time << ",\n";
+            out << "      \"time_unit\": \"ns\",\n";
+            out << "      \"items_per_second\": " << r.items_per_second << "\n";
+            out << "    }";
+        }
+        out << "\n  ]\n";
+        out << "}\n";
+    }
+
+    // Inputs ------------------------------------------------------------------
+
+    template<typename T>
+    using aligned_vector = std::vector<T, geo::aligned_allocator<T>>;
+
+    constexpr std::size_t batch_size = 1024;
+
+    template<typename K>
+    aligned_vector<geo::point<K>> make_points(std::size_t count, unsigned seed)
+    {
+        std::mt19937 engine {seed};
+        std::uniform_real_distribution<typename K::scalar> coord_dist {-1, 1};
+
+        aligned_vector<geo::point<K>> points(count);
+        for (auto& p : points) {
+            for (auto& coord : p) {
+                coord = coord_dist(engine);
+            }
+        }
+        return points;
+    }
+
+    template<typename K>
+    aligned_vector<geo::vector<K>> make_vectors(std::size_t count, unsigned seed)
+    {
+        auto const points = make_points<K>(count, seed);
+        aligned_vector<geo::vector<K>> vectors;
+        vectors.reserve(count);
+        for (auto const& p : points) {
+            vectors.push_back(p - geo::point<K>{});
+        }
+        return vectors;
+    }
+
+    template<typename T>
+    char const* scalar_name();
+
+    template<>
+    char const* scalar_name<float>()
+    {
+        return "float";
+    }
+
+    template<>
+    char const* scalar_name<double>()
+    {
+        return "double";
+    }
+
+    template<typename T, unsigned N>
+    std::string benchmark_name(char const* what)
+    {
+        return std::string(what) + "<" + scalar_name<T>() + "," + std::to_string(N) + ">";
+    }
+
+    // Benchmarks --------------------------------------------------------------
+
+    template<typename T, unsigned N>
+    void benchmark_vector_ops()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        auto const ps = make_points<K>(batch_size, 1);
+        auto const qs = make_points<K>(batch_size, 2);
+        auto const vs = make_vectors<K>(batch_size, 3);
+
+        run_benchmark(benchmark_name<T, N>("squared_distance"), batch_size, [&] {
+            T sum = 0;
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                sum += squared_distance(ps[i], qs[i]);
+            }
+            do_not_optimize(sum);
+        });
+
+        run_benchmark(benchmark_name<T, N>("normalize"), batch_size, [&] {
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                auto const u = normalize(vs[i]);
+                do_not_optimize(u);
+            }
+        });
+
+        // Fused into one pass when built with -DGEO_EXPRESSION_TEMPLATES.
+        auto const ws = make_vectors<K>(batch_size, 4);
+        auto const xs = make_vectors<K>(batch_size, 5);
+        T const k = T(0.75);
+        run_benchmark(benchmark_name<T, N>("linear_combination"), batch_size, [&] {
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                geo::vector<K> const u = vs[i] + ws[i] * k - xs[i] / k;
+                do_not_optimize(u);
+            }
+        });
+
+        geo::scaling_transformation<K> scaling;
+        for (unsigned i = 0; i < N; ++i) {
+            scaling[i] = T(1) + T(i) / 8;
+        }
+        run_benchmark(benchmark_name<T, N>("scaling_transformation"), batch_size, [&] {
+            for (std::size_t i = 0; i < batch_size; ++i) {
+                auto const u = scaling(vs[i]);
+                do_not_optimize(u);
+            }
+        });
+    }
+
+    template<typename Shape>
+    void benchmark_shape(std::string const& suffix, Shape const& shape,
+                         aligned_vector<geo::point<typename Shape::kernel>> const& ps)
+    {
+        run_benchmark("potential" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                do_not_optimize(shape.potential(p));
+            }
+        });
+
+        run_benchmark("gradient" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                auto const g = shape.gradient(p);
+                do_not_optimize(g);
+            }
+        });
+
+        run_benchmark("oriented_distance" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                do_not_optimize(shape.oriented_distance(p));
+            }
+        });
+
+        run_benchmark("skin_map" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                auto const m = shape.skin_map(p);
+                do_not_optimize(m);
+            }
+        });
+
+        run_benchmark("evaluate" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                auto const e = shape.evaluate(p);
+                do_not_optimize(e);
+            }
+        });
+
+        run_benchmark("bounding_box" + suffix, 1, [&] {
+            auto const b = bounding_box(shape);
+            do_not_optimize(b);
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_shapes()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        auto const ps = make_points<K>(batch_size, 4);
+
+        geo::point<K> center;
+        geo::scaling_transformation<K> semiaxes;
+        for (unsigned i = 0; i < N; ++i) {
+            center[i] = T(0.1) * T(i);
+            semiaxes[i] = T(0.5) + T(i) / 4;
+        }
+
+        std::string const suffix = benchmark_name<T, N>("");
+        benchmark_shape("/sphere" + suffix, geo::sphere<K>{center, T(0.7)}, ps);
+        benchmark_shape("/ellipsoid" + suffix, geo::ellipsoid<K>{center, semiaxes}, ps);
+
+        geo::ellipsoid<K> const ellipsoid {center, semiaxes};
+        std::vector<typename K::metric> distances(batch_size);
+        aligned_vector<geo::point<K>> feet(batch_size);
+
+        run_benchmark("exact_oriented_distance/ellipsoid" + suffix, batch_size, [&] {
+            for (auto const& p : ps) {
+                do_not_optimize(ellipsoid.exact_oriented_distance(p));
+            }
+        });
+
+        run_benchmark("oriented_distances/ellipsoid" + suffix, batch_size, [&] {
+            geo::oriented_distances(ellipsoid, ps.data(), ps.size(), distances.data());
+            do_not_optimize(distances.data());
+        });
+
+        run_benchmark("exact_oriented_distances/ellipsoid" + suffix, batch_size, [&] {
+            geo::exact_oriented_distances(ellipsoid, ps.data(), ps.size(), distances.data());
+            do_not_optimize(distances.data());
+        });
+
+        run_benchmark("closest_points/ellipsoid" + suffix, batch_size, [&] {
+            geo::closest_points(ellipsoid, ps.data(), ps.size(), feet.data());
+            do_not_optimize(feet.data());
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_centroid()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        constexpr std::size_t count = std::size_t(1) << 16;
+        auto const ps = make_points<K>(count, 5);
+
+        run_benchmark(benchmark_name<T, N>("centroid"), count, [&] {
+            auto const c = geo::centroid<K>(ps.begin(), ps.end());
+            do_not_optimize(c);
+        });
+
+        run_benchmark(benchmark_name<T, N>("centroid/seq"), count, [&] {
+            auto const c = geo::centroid<K>(geo::execution::seq, ps.begin(), ps.end());
+            do_not_optimize(c);
+        });
+
+        run_benchmark(benchmark_name<T, N>("centroid/par"), count, [&] {
+            auto const c = geo::centroid<K>(geo::execution::par, ps.begin(), ps.end());
+            do_not_optimize(c);
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_io()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        constexpr std::size_t count = 4096;
+        auto const ps = make_points<K>(count, 6);
+
+        std::ostringstream text;
+        text.precision(std::numeric_limits<T>::max_digits10);
+        for (auto const& p : ps) {
+            text << p << '\n';
+        }
+        std::string const text_data = text.str();
+
+        run_benchmark(benchmark_name<T, N>("stream_output"), count, [&] {
+            std::ostringstream out;
+            out.precision(std::numeric_limits<T>::max_digits10);
+            for (auto const& p : ps) {
+                out << p << '\n';
+            }
+            do_not_optimize(out.tellp());
+        });
+
+        run_benchmark(benchmark_name<T, N>("stream_input"), count, [&] {
+            std::istringstream in {text_data};
+            geo::point<K> p;
+            std::size_t n = 0;
+            while (in >> p) {
+                n++;
+            }
+            do_not_optimize(n);
+        });
+
+        run_benchmark(benchmark_name<T, N>("write_text"), count, [&] {
+            std::ostringstream out;
+            geo::write_text<K>(out, ps.begin(), ps.end());
+            do_not_optimize(out.tellp());
+        });
+
+        run_benchmark(benchmark_name<T, N>("read_text"), count, [&] {
+            std::istringstream in {text_data};
+            aligned_vector<geo::point<K>> points;
+            geo::read_text<K>(in, points);
+            do_not_optimize(points.data());
+        });
+
+        std::ostringstream binary;
+        geo::write_binary<K>(binary, ps.begin(), ps.end());
+        std::string const binary_data = binary.str();
+
+        run_benchmark(benchmark_name<T, N>("write_binary"), count, [&] {
+            std::ostringstream out;
+            geo::write_binary<K>(out, ps.begin(), ps.end());
+            do_not_optimize(out.tellp());
+        });
+
+        run_benchmark(benchmark_name<T, N>("read_binary"), count, [&] {
+            std::istringstream in {binary_data};
+            aligned_vector<geo::point<K>> points;
+            geo::read_binary<K>(in, points);
+            do_not_optimize(points.data());
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_spatial_sort()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        constexpr std::size_t count = std::size_t(1) << 16;
+        auto const ps = make_points<K>(count, 7);
+        auto const queries = make_points<K>(count, 8);
+
+        geo::point<K> low;
+        geo::point<K> high;
+        for (unsigned i = 0; i < N; ++i) {
+            low[i] = -1;
+            high[i] = 1;
+        }
+        geo::box<K> const domain {low, high};
+
+        run_benchmark(benchmark_name<T, N>("spatial_sort/morton"), count, [&] {
+            auto points = ps;
+            auto const perm = geo::spatial_sort(
+                points.begin(), points.end(), domain, geo::space_filling_curve::morton
+            );
+            do_not_optimize(perm.data());
+        });
+
+        run_benchmark(benchmark_name<T, N>("spatial_sort/hilbert"), count, [&] {
+            auto points = ps;
+            auto const perm = geo::spatial_sort(points.begin(), points.end(), domain);
+            do_not_optimize(perm.data());
+        });
+
+        // The same queries in random and in curve order show the effect of
+        // locality on the tree traversal.
+        auto sorted_queries = queries;
+        geo::spatial_sort(sorted_queries.begin(), sorted_queries.end(), domain);
+        geo::kd_tree<K> const tree {ps.begin(), ps.end()};
+
+        run_benchmark(benchmark_name<T, N>("kd_tree_nearest/random"), count, [&] {
+            for (auto const& q : queries) {
+                do_not_optimize(tree.nearest(q));
+            }
+        });
+
+        run_benchmark(benchmark_name<T, N>("kd_tree_nearest/hilbert"), count, [&] {
+            for (auto const& q : sorted_queries) {
+                do_not_optimize(tree.nearest(q));
+            }
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_octree()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        constexpr std::size_t count = std::size_t(1) << 14;
+        auto const ps = make_points<K>(count, 9);
+
+        geo::inverse_distance_potential<T> potential;
+        potential.softening = T(0.01);
+
+        run_benchmark(benchmark_name<T, N>("octree_build"), count, [&] {
+            geo::octree<K> const tree {ps.begin(), ps.end()};
+            do_not_optimize(tree.node_count());
+        });
+
+        geo::octree<K> const tree {ps.begin(), ps.end()};
+
+        run_benchmark(benchmark_name<T, N>("octree_energy/theta=0.5"), count, [&] {
+            do_not_optimize(tree.energy(potential, T(0.5)));
+        });
+
+        run_benchmark(benchmark_name<T, N>("octree_energy/theta=0.5/par"), count, [&] {
+            do_not_optimize(tree.energy(geo::execution::par, potential, T(0.5)));
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_broad_phase()
+    {
+        using K = geo::standard_kernel<T, N>;
+
+        constexpr std::size_t count = std::size_t(1) << 14;
+        auto const ps = make_points<K>(count, 10);
+        auto const vs = make_vectors<K>(count, 11);
+
+        // Spheres of about the mean spacing, in two frames a small step
+        // apart, so that every update re-sorts nearly sorted endpoints.
+        auto const radius = T(std::pow(1.0 / count, 1.0 / N));
+        auto const step = radius / 16;
+
+        aligned_vector<geo::sphere<K>> frames[2];
+        for (std::size_t i = 0; i < count; ++i) {
+            frames[0].emplace_back(ps[i], radius);
+            frames[1].emplace_back(ps[i] + step * vs[i], radius);
+        }
+
+        geo::sweep_and_prune<K> broad_phase;
+        std::vector<std::pair<std::size_t, std::size_t>> pairs;
+        unsigned frame = 0;
+
+        run_benchmark(benchmark_name<T, N>("sweep_and_prune"), count, [&] {
+            auto const& spheres = frames[frame ^= 1];
+            broad_phase.update(spheres.begin(), spheres.end());
+            pairs.clear();
+            broad_phase.overlapping_pairs(std::back_inserter(pairs));
+            do_not_optimize(pairs.data());
+        });
+
+        // Same frames kept in a pool, where every shape is moved and the
+        // broad phase reads the cached boxes.
+        geo::shape_pool<geo::sphere<K>> pool;
+        std::vector<typename geo::shape_pool<geo::sphere<K>>::handle_type> handles;
+        for (auto const& s : frames[0]) {
+            handles.push_back(pool.insert(s));
+        }
+
+        run_benchmark(benchmark_name<T, N>("sweep_and_prune/shape_pool"), count, [&] {
+            auto const& spheres = frames[frame ^= 1];
+            for (std::size_t i = 0; i < count; ++i) {
+                pool.modify(handles[i]) = spheres[i];
+            }
+            auto const boxes = pool.bounding_boxes();
+            broad_phase.update(boxes, boxes + pool.size());
+            pairs.clear();
+            broad_phase.overlapping_pairs(std::back_inserter(pairs));
+            do_not_optimize(pairs.data());
+        });
+
+        // Steady churn: erase a random shape and insert a new one.
+        std::mt19937 engine {12};
+        std::uniform_int_distribution<std::size_t> pick {0, count - 1};
+        std::size_t next = 0;
+
+        run_benchmark(benchmark_name<T, N>("shape_pool/churn"), 1, [&] {
+            std::size_t const i = pick(engine);
+            pool.erase(handles[i]);
+            handles[i] = pool.insert(frames[0][next++ % count]);
+            do_not_optimize(pool.data());
+        });
+    }
+
+    // The dimension is passed to the arena at run time. N only names the
+    // benchmark.
+    template<typename T, unsigned N>
+    void benchmark_dynamic()
+    {
+        using K = geo::dynamic_kernel<T>;
+
+        std::mt19937 engine {N};
+        std::uniform_real_distribution<T> coord_dist {-1, 1};
+        std::vector<T> coords(N);
+
+        geo::dynamic_arena<K> arena {N};
+        for (std::size_t i = 0; i < batch_size; ++i) {
+            for (T& coord : coords) {
+                coord = coord_dist(engine);
+            }
+            arena.append(coords.data());
+        }
+
+        run_benchmark(benchmark_name<T, N>("dynamic_squared_distance"), batch_size, [&] {
+            T sum = 0;
+            for (std::size_t i = 1; i < batch_size; ++i) {
+                sum += squared_distance(arena.point(i - 1), arena.point(i));
+            }
+            do_not_optimize(sum);
+        });
+
+        run_benchmark(benchmark_name<T, N>("dynamic_inner_product"), batch_size, [&] {
+            T sum = 0;
+            for (std::size_t i = 1; i < batch_size; ++i) {
+                sum += inner_product(arena.vector(i - 1), arena.vector(i));
+            }
+            do_not_optimize(sum);
+        });
+    }
+
+    template<typename T, unsigned N>
+    void benchmark_all()
+    {
+        benchmark_vector_ops<T, N>();
+        benchmark_shapes<T, N>();
+        benchmark_centroid<T, N>();
+        benchmark_io<T, N>();
+        benchmark_spatial_sort<T, N>();
+        benchmark_octree<T, N>();
+        benchmark_broad_phase<T, N>();
+    }
+}
+
+int main(int argc, char** argv)
+{
+    if (argc > 1) {
+        filter = argv[1];
+    }
+
+    benchmark_all<float, 2>();
+    benchmark_all<float, 3>();
+    benchmark_all<float, 4>();
+    benchmark_all<float, 8>();
+    benchmark_all<double, 2>();
+    benchmark_all<double, 3>();
+    benchmark_all<double, 4>();
+    benchmark_all<double, 8>();
+
+    benchmark_dynamic<float, 16>();
+    benchmark_dynamic<float, 128>();
+    benchmark_dynamic<float, 512>();
+    benchmark_dynamic<double, 16>();
+    benchmark_dynamic<double, 128>();
+    benchmark_dynamic<double, 512>();
+
+    print_json(std::cout);
+}
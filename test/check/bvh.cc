@@ -0,0 +1,129 @@
+// Compares bvh::nearest_surface with a brute-force scan over the shapes for
+// ellipsoids, whose approximate oriented distance underestimates the true
+// distance far from the surface, oriented ellipsoids, which have no exact
+// distance, and spheres, whose distance is exact. Exits with a nonzero status
+// on mismatch, e.g.
+//
+//   c++ -std=c++14 -O2 -pthread -I include test/check/bvh.cc && ./a.out
+
+#include <cmath>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#include <geo/all.hpp>
+
+namespace
+{
+    using kernel = geo::standard_kernel<double, 3>;
+    using point_type = geo::point<kernel>;
+    using scaling_type = geo::scaling_transformation<kernel>;
+
+    std::mt19937 random_engine;
+
+    point_type random_point(double low, double high)
+    {
+        std::uniform_real_distribution<double> coord {low, high};
+        point_type p;
+        for (unsigned i = 0; i < kernel::dimension; ++i) {
+            p[i] = coord(random_engine);
+        }
+        return p;
+    }
+
+    scaling_type random_semiaxes()
+    {
+        std::uniform_real_distribution<double> semiaxis {0.01, 0.5};
+        scaling_type s;
+        for (unsigned i = 0; i < kernel::dimension; ++i) {
+            s[i] = semiaxis(random_engine);
+        }
+        return s;
+    }
+
+    // Counts queries where the hierarchy returns a shape farther than the
+    // nearest one found by scanning every shape with given distance.
+    template<typename Shape, typename Distance>
+    std::size_t count_mismatches(std::vector<Shape> const& shapes,
+                                 Distance distance, std::size_t query_count)
+    {
+        geo::bvh<Shape> const tree(shapes.begin(), shapes.end());
+
+        std::size_t mismatches = 0;
+        for (std::size_t q = 0; q < query_count; ++q) {
+            point_type const p = random_point(-2, 3);
+
+            double nearest = std::numeric_limits<double>::infinity();
+            for (Shape const& shape : shapes) {
+                nearest = std::min(nearest, std::abs(distance(shape, p)));
+            }
+
+            std::size_t const found = tree.nearest_surface(p);
+            if (std::abs(distance(shapes[found], p)) != nearest) {
+                mismatches++;
+            }
+        }
+        return mismatches;
+    }
+
+    bool check(std::string const& name, std::size_t mismatches)
+    {
+        std::cout << name << ": " << mismatches << " mismatches\n";
+        return mismatches == 0;
+    }
+}
+
+int main()
+{
+    std::size_t const shape_count = 500;
+    std::size_t const query_count = 2000;
+    bool ok = true;
+
+    std::vector<geo::ellipsoid<kernel>> ellipsoids;
+    for (std::size_t i = 0; i < shape_count; ++i) {
+        ellipsoids.emplace_back(random_point(0, 1), random_semiaxes());
+    }
+    ok &= check("ellipsoid", count_mismatches(
+        ellipsoids,
+        [](geo::ellipsoid<kernel> const& e, point_type const& p) {
+            return e.exact_oriented_distance(p);
+        },
+        query_count
+    ));
+
+    std::vector<geo::oriented_ellipsoid<kernel>> oriented_ellipsoids;
+    for (std::size_t i = 0; i < shape_count; ++i) {
+        double const angle = double(i);
+        geo::linear_transformation<kernel> rotation;
+        rotation.element(0, 0) = std::cos(angle);
+        rotation.element(0, 1) = -std::sin(angle);
+        rotation.element(1, 0) = std::sin(angle);
+        rotation.element(1, 1) = std::cos(angle);
+        oriented_ellipsoids.emplace_back(random_point(0, 1), random_semiaxes(), rotation);
+    }
+    ok &= check("oriented_ellipsoid", count_mismatches(
+        oriented_ellipsoids,
+        [](geo::oriented_ellipsoid<kernel> const& e, point_type const& p) {
+            return e.oriented_distance(p);
+        },
+        query_count
+    ));
+
+    std::vector<geo::sphere<kernel>> spheres;
+    std::uniform_real_distribution<double> radius {0.01, 0.5};
+    for (std::size_t i = 0; i < shape_count; ++i) {
+        spheres.emplace_back(random_point(0, 1), radius(random_engine));
+    }
+    ok &= check("sphere", count_mismatches(
+        spheres,
+        [](geo::sphere<kernel> const& s, point_type const& p) {
+            return s.oriented_distance(p);
+        },
+        query_count
+    ));
+
+    return ok ? 0 : 1;
+}
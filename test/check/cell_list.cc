@@ -0,0 +1,76 @@
+// Compares the pair and neighbor queries of cell_list with a brute-force scan
+// for cutoffs from zero to far beyond the domain, including infinity. Large
+// cutoffs must not enumerate offsets beyond the grid. Exits with a nonzero
+// status on mismatch, e.g.
+//
+//   c++ -std=c++14 -O2 -pthread -I include test/check/cell_list.cc && ./a.out
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <geo/all.hpp>
+
+int main()
+{
+    using kernel = geo::standard_kernel<double, 3>;
+    using point_type = geo::point<kernel>;
+    using pair_type = std::pair<std::size_t, std::size_t>;
+
+    std::mt19937 random_engine;
+    std::uniform_real_distribution<double> coord {0, 1};
+    std::vector<point_type> points;
+    for (std::size_t i = 0; i < 200; ++i) {
+        point_type p;
+        for (unsigned axis = 0; axis < kernel::dimension; ++axis) {
+            p[axis] = coord(random_engine);
+        }
+        points.push_back(p);
+    }
+
+    geo::box<kernel> const domain {point_type {0, 0, 0}, point_type {1, 1, 1}};
+    geo::cell_list<kernel> const cells {points.begin(), points.end(), domain, 0.05};
+    point_type const query {0.3, 0.6, 0.9};
+
+    bool ok = true;
+    for (double const cutoff : {0.0, 0.05, 0.2, 2.0, 20.0, 200.0,
+                                std::numeric_limits<double>::infinity()}) {
+        double const squared_cutoff = cutoff * cutoff;
+
+        std::vector<pair_type> expected_pairs;
+        std::vector<std::size_t> expected_neighbors;
+        for (std::size_t i = 0; i < points.size(); ++i) {
+            for (std::size_t j = i + 1; j < points.size(); ++j) {
+                if (geo::squared_distance(points[i], points[j]) <= squared_cutoff) {
+                    expected_pairs.emplace_back(i, j);
+                }
+            }
+            if (geo::squared_distance(query, points[i]) <= squared_cutoff) {
+                expected_neighbors.push_back(i);
+            }
+        }
+
+        std::vector<pair_type> pairs;
+        cells.for_each_pair_within(cutoff, [&](std::size_t i, std::size_t j, double) {
+            pairs.emplace_back(std::min(i, j), std::max(i, j));
+        });
+        std::sort(pairs.begin(), pairs.end());
+
+        std::vector<std::size_t> neighbors;
+        cells.for_each_neighbor(query, cutoff, [&](std::size_t i, double) {
+            neighbors.push_back(i);
+        });
+        std::sort(neighbors.begin(), neighbors.end());
+
+        bool const match = pairs == expected_pairs && neighbors == expected_neighbors;
+        std::cout << "cutoff " << cutoff << ": " << pairs.size() << " pairs, "
+                  << neighbors.size() << " neighbors"
+                  << (match ? "" : " (mismatch)") << '\n';
+        ok = ok && match;
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,76 @@
+// Churns a shape_pool with random erasures and insertions and checks that the
+// live handles still address their shapes, that erased handles are rejected
+// even after their slot is reissued, and that the cached boxes match the
+// shapes. Exits with a nonzero status on mismatch, e.g.
+//
+//   c++ -std=c++14 -O2 -pthread -I include test/check/shape_pool.cc && ./a.out
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <vector>
+
+#include <geo/all.hpp>
+
+int main()
+{
+    using kernel = geo::standard_kernel<double, 3>;
+    using point_type = geo::point<kernel>;
+    using sphere_type = geo::sphere<kernel>;
+    using pool_type = geo::shape_pool<sphere_type>;
+
+    std::mt19937 random_engine;
+    std::uniform_real_distribution<double> coord {0, 1};
+    auto const random_sphere = [&] {
+        point_type const center {coord(random_engine), coord(random_engine),
+                                 coord(random_engine)};
+        return sphere_type {center, 0.01 + coord(random_engine)};
+    };
+
+    pool_type pool;
+    std::vector<pool_type::handle_type> handles;
+    std::vector<sphere_type> spheres;
+    std::vector<pool_type::handle_type> erased;
+    for (std::size_t i = 0; i < 100; ++i) {
+        spheres.push_back(random_sphere());
+        handles.push_back(pool.insert(spheres.back()));
+    }
+
+    std::uniform_int_distribution<std::size_t> pick {0, handles.size() - 1};
+    for (std::size_t step = 0; step < 1000; ++step) {
+        std::size_t const i = pick(random_engine);
+        pool.erase(handles[i]);
+        erased.push_back(handles[i]);
+        spheres[i] = random_sphere();
+        handles[i] = pool.insert(spheres[i]);
+        if (step % 3 == 0) {
+            std::size_t const j = pick(random_engine);
+            spheres[j] = random_sphere();
+            pool.modify(handles[j]) = spheres[j];
+        }
+    }
+
+    bool ok = pool.size() == handles.size() && !pool.contains(pool_type::null_handle);
+    for (pool_type::handle_type const handle : erased) {
+        ok = ok && !pool.contains(handle);
+    }
+
+    auto const boxes = pool.bounding_boxes();
+    for (std::size_t i = 0; i < handles.size(); ++i) {
+        if (!pool.contains(handles[i])) {
+            ok = false;
+            continue;
+        }
+        std::size_t const index = pool.index(handles[i]);
+        sphere_type const& s = pool[handles[i]];
+        geo::box<kernel> const expected = geo::bounding_box(spheres[i]);
+        ok = ok && pool.handle(index) == handles[i] &&
+             s.center() == spheres[i].center() && s.radius() == spheres[i].radius() &&
+             boxes[index].lowest_vertex() == expected.lowest_vertex() &&
+             boxes[index].highest_vertex() == expected.highest_vertex();
+    }
+
+    std::cout << handles.size() << " live handles, " << erased.size()
+              << " erased handles" << (ok ? "" : " (mismatch)") << '\n';
+    return ok ? 0 : 1;
+}
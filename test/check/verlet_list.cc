@@ -0,0 +1,61 @@
+// Builds a verlet_list over points in the unit cube plus one far outlier and
+// compares its pairs with a brute-force scan. The outlier stretches the domain
+// of the underlying cell list to 10^4 times the cell width per axis, which
+// must not allocate a grid of 10^12 cells. Exits with a nonzero status on
+// mismatch, e.g.
+//
+//   c++ -std=c++14 -O2 -pthread -I include test/check/verlet_list.cc && ./a.out
+
+#include <cstddef>
+#include <iostream>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include <geo/all.hpp>
+
+int main()
+{
+    using kernel = geo::standard_kernel<double, 3>;
+    using point_type = geo::point<kernel>;
+
+    double const cutoff = 0.01;
+    double const skin = 0.002;
+
+    std::mt19937 random_engine;
+    std::uniform_real_distribution<double> coord {0, 1};
+    std::vector<point_type> points;
+    for (std::size_t i = 0; i < 1000; ++i) {
+        point_type p;
+        for (unsigned axis = 0; axis < kernel::dimension; ++axis) {
+            p[axis] = coord(random_engine);
+        }
+        points.push_back(p);
+    }
+    points.push_back(point_type {100, 100, 100});
+
+    geo::verlet_list<kernel> list {cutoff, skin};
+    list.rebuild(points.begin(), points.end());
+
+    std::vector<std::pair<std::size_t, std::size_t>> expected;
+    double const reach = cutoff + skin;
+    for (std::size_t i = 0; i < points.size(); ++i) {
+        for (std::size_t j = i + 1; j < points.size(); ++j) {
+            if (geo::squared_distance(points[i], points[j]) <= reach * reach) {
+                expected.emplace_back(i, j);
+            }
+        }
+    }
+
+    std::vector<std::pair<std::size_t, std::size_t>> actual;
+    for (std::size_t i = 0; i < list.size(); ++i) {
+        for (std::size_t const j : list.neighbors(i)) {
+            actual.emplace_back(i, j);
+        }
+    }
+
+    bool const ok = actual == expected;
+    std::cout << "verlet_list with outlier: " << actual.size() << " pairs, "
+              << expected.size() << " expected\n";
+    return ok ? 0 : 1;
+}